@@ -0,0 +1,114 @@
+#ifndef _WLCPP_ARRAY_VIEW_HPP_
+#define _WLCPP_ARRAY_VIEW_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <wayland-client.h>
+
+namespace wlcpp {
+
+/** \brief Non-owning, typed view of a contiguous array
+ *
+ *  Refers to the elements of a wl_array without copying them. The elements are
+ *  accessed through plain pointers, so loops over a view can be vectorized by
+ *  the compiler. An array_view passed to an event handler is only valid until
+ *  the handler returns.
+ */
+template <typename T>
+class array_view {
+public:
+    using value_type = typename std::remove_cv<T>::type;
+    using iterator = T*;
+    using const_iterator = T*;
+
+    array_view()
+        : _data(nullptr),
+          _size(0) {
+    }
+
+    array_view(T* data, std::size_t size)
+        : _data(data),
+          _size(size) {
+    }
+
+    template <std::size_t N>
+    array_view(T (&data)[N])
+        : _data(data),
+          _size(N) {
+    }
+
+    /** \brief View the elements of a container with data() and size() members, such as std::vector
+     */
+    template <typename Container, typename = decltype(static_cast<T*>(std::declval<Container&>().data()))>
+    array_view(Container&& container)
+        : _data(container.data()),
+          _size(container.size()) {
+    }
+
+    /** \brief View the contents of a wl_array
+     *
+     *  Trailing bytes which do not form a complete element are ignored.
+     */
+    explicit array_view(const wl_array& array)
+        : _data(static_cast<T*>(array.data)),
+          _size(array.size / sizeof(T)) {
+    }
+
+    /** \brief Allow conversion from array_view<U> to array_view<const U>
+     */
+    template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    array_view(array_view<U> rhs)
+        : _data(rhs.data()),
+          _size(rhs.size()) {
+    }
+
+    T* data() const {
+        return _data;
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    std::size_t size_bytes() const {
+        return _size * sizeof(T);
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    iterator begin() const {
+        return _data;
+    }
+
+    iterator end() const {
+        return _data + _size;
+    }
+
+    T& operator[](std::size_t pos) const {
+        return _data[pos];
+    }
+
+    /** \brief Create a wl_array header referring to the viewed elements
+     *
+     *  The elements are not copied. The returned wl_array must not be released
+     *  with wl_array_release and is only valid as long as the viewed elements.
+     */
+    wl_array to_wl_array() const {
+        wl_array result;
+        result.size = size_bytes();
+        result.alloc = size_bytes();
+        result.data = const_cast<value_type*>(_data);
+        return result;
+    }
+
+private:
+    T* _data;
+    std::size_t _size;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_ARRAY_VIEW_HPP_
@@ -0,0 +1,34 @@
+#include <cstdlib>
+#include <new>
+#include "harness.hpp"
+
+using namespace std;
+
+// Replaces operator new and delete of the program to count allocations.
+
+namespace {
+
+uint64_t allocation_count = 0;
+
+} // namespace
+
+uint64_t wlcpp::allocations() {
+    return allocation_count;
+}
+
+void* operator new(size_t size) {
+    ++allocation_count;
+    void* result = malloc(size);
+    if(!result) {
+        throw bad_alloc();
+    }
+    return result;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
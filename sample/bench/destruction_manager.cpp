@@ -0,0 +1,133 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include "harness.hpp"
+#include "../destruction_manager.hpp"
+#include "../generated/compositor.hpp"
+#include "../generated/display.hpp"
+#include "../generated/region.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+// Compares regions which are allocated on the heap and destroyed at once with
+// regions which are owned by a destruction_manager. Every frame creates and
+// destroys a number of regions and ends with a roundtrip, which is the sync
+// barrier of the manager or an explicit wl_display.sync. A fake_compositor
+// answers every wl_region.destroy with wl_display.delete_id and every
+// wl_display.sync with wl_callback.done and wl_display.delete_id.
+
+namespace {
+
+const uint32_t destroy_opcode = 0;
+const uint32_t sync_opcode = 0;
+const unsigned regions_per_frame = 8;
+
+// Reads requests up to the next wl_display.sync and sends the events which
+// complete them.
+bool complete_frame(fake_compositor& peer) {
+    for(;;) {
+        if(!peer.read_request()) {
+            return false;
+        }
+
+        if(peer.request_object() == fake_compositor::display_id && peer.request_opcode() == sync_opcode) {
+            return peer.queue_done(peer.request_arg(0)) && peer.send_events();
+        }
+
+        if(peer.request_opcode() == destroy_opcode && peer.request_size() == 8 && !peer.queue_delete_id(peer.request_object())) {
+            return false;
+        }
+    }
+}
+
+template <typename Frame, typename Done>
+double measure_ns(display& d, fake_compositor& peer, uint64_t frames, uint64_t& frame_allocations, Frame frame, Done done) {
+    uint64_t start_allocations = allocations();
+    auto start = chrono::steady_clock::now();
+    for(uint64_t i = 0; i < frames; ++i) {
+        frame();
+        if(d.flush() < 0 || !complete_frame(peer)) {
+            return -1.0;
+        }
+        while(!done()) {
+            if(d.dispatch() < 0) {
+                return -1.0;
+            }
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    frame_allocations = allocations() - start_allocations;
+    return chrono::duration<double, nano>(end - start).count() / (frames * regions_per_frame);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const uint64_t frames = 50000;
+    const uint64_t objects = frames * regions_per_frame;
+
+    fake_compositor peer;
+    if(!peer.valid()) {
+        cerr << "socketpair failed" << endl;
+        return 1;
+    }
+
+    display d(peer.client_fd());
+    if(!d.valid()) {
+        cerr << "wl_display_connect_to_fd failed" << endl;
+        return 1;
+    }
+    compositor c(d);
+
+    uint64_t heap_allocations = 0;
+    unique_ptr<region> heap_regions[regions_per_frame];
+    callback cb;
+    bool synced = false;
+    double heap_object = measure_ns(d, peer, frames, heap_allocations, [&]() {
+        for(auto& r : heap_regions) {
+            r.reset(new region(c.create_region()));
+            r->add(0, 0, 64, 64);
+        }
+        for(auto& r : heap_regions) {
+            r.reset();
+        }
+        synced = false;
+        cb = d.sync();
+        cb.set_done_handler([&synced](uint32_t serial) {
+            synced = true;
+        });
+    }, [&]() {
+        return synced;
+    });
+    cb = callback();
+
+    uint64_t manager_allocations = 0;
+    destruction_manager manager(d);
+    region* managed_regions[regions_per_frame];
+    double manager_object = measure_ns(d, peer, frames, manager_allocations, [&]() {
+        for(auto& r : managed_regions) {
+            r = &manager.adopt(c.create_region());
+            r->add(0, 0, 64, 64);
+        }
+        for(auto& r : managed_regions) {
+            manager.destroy(*r);
+        }
+        manager.flush();
+    }, [&]() {
+        return manager.pending() == 0;
+    });
+
+    if(heap_object < 0.0 || manager_object < 0.0) {
+        cerr << "region destruction failed" << endl;
+        return 1;
+    }
+
+    cout << "regions            ns/object   allocations/object (operator new)" << endl;
+    cout << "heap               " << heap_object << "   " << static_cast<double>(heap_allocations) / objects << endl;
+    cout << "destruction_manager " << manager_object << "   " << static_cast<double>(manager_allocations) / objects << endl;
+    cout << "pending " << manager.pending() << ", free slots " << manager.free_slots() << endl;
+
+    return 0;
+}
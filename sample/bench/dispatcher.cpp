@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <wayland-client.h>
+#include "harness.hpp"
+#include "dispatcher_wayland.hpp"
+#include "listener_wayland.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+// Compares wl_pointer.motion delivered to the classes which wlcppgen generates
+// with and without --dispatcher. The build generates the core protocol once for
+// each, with the class prefixes listener_ and dispatcher_, so both can be linked
+// into this program. listener_pointer installs its listener of trampolines, which
+// libwayland calls through libffi, and dispatcher_pointer installs its dispatcher
+// through proxy::add_dispatcher(). A fake_compositor sends motion events to both
+// objects. Both event paths
+// go through the complete libwayland read and dispatch code and end in the same
+// handler.
+
+namespace {
+
+const uint32_t motion_opcode = 2;
+const size_t motion_size = 20;
+const size_t batch = 200;
+
+struct motion_counter {
+    uint64_t events = 0;
+    int64_t distance = 0;
+
+    void motion(uint32_t time_, wl_fixed_t surface_x_, wl_fixed_t surface_y_) {
+        ++events;
+        distance += surface_x_ + surface_y_;
+    }
+};
+
+vector<uint32_t> motion_events(uint32_t id) {
+    vector<uint32_t> result;
+    for(size_t i = 0; i < batch; ++i) {
+        result.push_back(id);
+        result.push_back((motion_size << 16) | motion_opcode);
+        result.push_back(static_cast<uint32_t>(i));
+        result.push_back(static_cast<uint32_t>(i & 0xff));
+        result.push_back(256);
+    }
+    return result;
+}
+
+double measure_ns(wl_display* display, fake_compositor& peer, const proxy& target, motion_counter& counter, uint64_t events) {
+    vector<uint32_t> buffer = motion_events(target.get_id());
+    auto start = chrono::steady_clock::now();
+    for(uint64_t sent = 0; sent < events; sent += batch) {
+        if(!peer.send(buffer.data(), buffer.size())) {
+            return -1.0;
+        }
+        while(counter.events < sent + batch) {
+            if(wl_display_dispatch(display) < 0) {
+                return -1.0;
+            }
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(end - start).count() / events;
+}
+
+} // namespace
+
+// The wrappers are destroyed before the display is disconnected.
+int run(wl_display* display, fake_compositor& peer) {
+    const uint64_t events = 2000000;
+
+    proxy factory(reinterpret_cast<wl_proxy*>(display), false);
+
+    motion_counter listener_counter;
+    listener_pointer listener_wrapper(factory);
+    listener_wrapper.set_motion_handler([&listener_counter](uint32_t time_, wl_fixed_t surface_x_, wl_fixed_t surface_y_) {
+        listener_counter.motion(time_, surface_x_, surface_y_);
+    });
+
+    motion_counter dispatcher_counter;
+    dispatcher_pointer dispatcher_wrapper(factory);
+    dispatcher_wrapper.set_motion_handler([&dispatcher_counter](uint32_t time_, wl_fixed_t surface_x_, wl_fixed_t surface_y_) {
+        dispatcher_counter.motion(time_, surface_x_, surface_y_);
+    });
+
+    double listener_event = measure_ns(display, peer, listener_wrapper, listener_counter, events);
+    double dispatcher_event = measure_ns(display, peer, dispatcher_wrapper, dispatcher_counter, events);
+
+    if(listener_event < 0.0 || dispatcher_event < 0.0 || listener_counter.events != events || dispatcher_counter.events != events) {
+        cerr << "event delivery failed" << endl;
+        return 1;
+    }
+
+    cout << "event path       ns/event (including socket read and demarshalling)" << endl;
+    cout << "listener         " << listener_event << endl;
+    cout << "dispatcher       " << dispatcher_event << endl;
+    cout << "checksum " << listener_counter.distance + dispatcher_counter.distance << endl;
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    fake_compositor peer;
+    if(!peer.valid()) {
+        cerr << "socketpair failed" << endl;
+        return 1;
+    }
+
+    wl_display* display = wl_display_connect_to_fd(peer.client_fd());
+    if(!display) {
+        cerr << "wl_display_connect_to_fd failed" << endl;
+        return 1;
+    }
+
+    int result = run(display, peer);
+
+    wl_display_disconnect(display);
+
+    return result;
+}
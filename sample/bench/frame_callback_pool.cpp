@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include "harness.hpp"
+#include "../frame_callback_pool.hpp"
+#include "../generated/display.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+// Compares frame callbacks from a frame_callback_pool with callbacks which are
+// allocated on the heap for every frame. A fake_compositor answers every
+// wl_surface.frame request with wl_callback.done and wl_display.delete_id.
+
+namespace {
+
+const uint32_t frame_opcode = 3;
+
+// Reads one wl_surface.frame request and sends the events which complete it.
+bool complete_frame(fake_compositor& peer) {
+    if(!peer.read_request() || peer.request_opcode() != frame_opcode) {
+        return false;
+    }
+    return peer.queue_done(peer.request_arg(0)) && peer.send_events();
+}
+
+template <typename RequestFrame>
+double measure_ns(display& d, fake_compositor& peer, uint64_t frames, uint64_t& frame_allocations, RequestFrame request_frame) {
+    uint64_t done = 0;
+    uint64_t start_allocations = allocations();
+    auto start = chrono::steady_clock::now();
+    for(uint64_t i = 0; i < frames; ++i) {
+        request_frame(done);
+        if(d.flush() < 0 || !complete_frame(peer)) {
+            return -1.0;
+        }
+        while(done <= i) {
+            if(d.dispatch() < 0) {
+                return -1.0;
+            }
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    frame_allocations = allocations() - start_allocations;
+    return chrono::duration<double, nano>(end - start).count() / frames;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const uint64_t frames = 200000;
+
+    fake_compositor peer;
+    if(!peer.valid()) {
+        cerr << "socketpair failed" << endl;
+        return 1;
+    }
+
+    display d(peer.client_fd());
+    if(!d.valid()) {
+        cerr << "wl_display_connect_to_fd failed" << endl;
+        return 1;
+    }
+    surface s(d);
+
+    uint64_t heap_allocations = 0;
+    unique_ptr<callback> current;
+    double heap_frame = measure_ns(d, peer, frames, heap_allocations, [&](uint64_t& done) {
+        current.reset(new callback(s.frame()));
+        current->set_done_handler([&done](uint32_t time) {
+            ++done;
+        });
+    });
+    current.reset();
+
+    uint64_t pool_allocations = 0;
+    frame_callback_pool pool;
+    double pool_frame = measure_ns(d, peer, frames, pool_allocations, [&](uint64_t& done) {
+        pool.request(s, [&done](uint32_t time) {
+            ++done;
+        });
+    });
+
+    if(heap_frame < 0.0 || pool_frame < 0.0) {
+        cerr << "frame callback delivery failed" << endl;
+        return 1;
+    }
+
+    cout << "frame callbacks  ns/frame   allocations/frame (operator new)" << endl;
+    cout << "heap             " << heap_frame << "   " << static_cast<double>(heap_allocations) / frames << endl;
+    cout << "pool             " << pool_frame << "   " << static_cast<double>(pool_allocations) / frames << endl;
+    cout << "pool capacity    " << pool.capacity() << endl;
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <wayland-client.h>
+#include "harness.hpp"
+#include "function_wayland.hpp"
+#include "static_wayland.hpp"
+
+using namespace std;
+using namespace std::placeholders;
+using namespace wlcpp;
+
+// Compares wl_pointer.motion handlers of the classes which wlcppgen generates with
+// --handler-model=function and --handler-model=static. The build generates the core
+// protocol once for each model, with the class prefixes function_ and static_, so
+// both can be linked into this program. Events are delivered through the listener
+// which the generated class installed, read from its wl_proxy and called through a
+// volatile pointer, just like libwayland calls the listener without knowing its
+// target. Reading and demarshalling events is left out, because it is the same for
+// both models.
+
+namespace {
+
+// Layout of the listener of wl_pointer up to the motion event.
+struct listener_t {
+    void (*enter_handler) ();
+    void (*leave_handler) ();
+    void (*motion_handler) (void*, wl_proxy*, uint32_t, wl_fixed_t, wl_fixed_t);
+};
+
+struct motion_counter {
+    uint64_t events = 0;
+    int64_t distance = 0;
+
+    void motion(uint32_t time_, wl_fixed_t surface_x_, wl_fixed_t surface_y_) {
+        ++events;
+        distance += surface_x_ + surface_y_;
+    }
+};
+
+class counting_pointer
+    : public basic_static_pointer<counting_pointer> {
+public:
+    explicit counting_pointer(proxy& factory)
+        : basic_static_pointer<counting_pointer>(factory) {
+    }
+
+    motion_counter counter;
+
+    void on_motion(uint32_t time_, wl_fixed_t surface_x_, wl_fixed_t surface_y_) {
+        counter.motion(time_, surface_x_, surface_y_);
+    }
+};
+
+template <typename F>
+double measure_ns(uint64_t iterations, F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(end - start).count() / iterations;
+}
+
+void dispatch(const listener_t* const volatile& listener, wl_proxy* obj, uint64_t events) {
+    void* data = wl_proxy_get_user_data(obj);
+    for(uint64_t i = 0; i < events; ++i) {
+        listener->motion_handler(data, obj, static_cast<uint32_t>(i), static_cast<wl_fixed_t>(i & 0xff), 256);
+    }
+}
+
+const listener_t* listener_of(const proxy& p) {
+    return static_cast<const listener_t*>(wl_proxy_get_listener(p.wl_obj()));
+}
+
+} // namespace
+
+// The wrappers are destroyed before the display is disconnected.
+int run(wl_display* display) {
+    const uint64_t events = 100000000;
+    const uint64_t registrations = 1000000;
+
+    proxy factory(reinterpret_cast<wl_proxy*>(display), false);
+
+    motion_counter function_counter;
+    function_pointer function_wrapper(factory);
+    function_wrapper.set_motion_handler(bind(&motion_counter::motion, &function_counter, _1, _2, _3));
+    const listener_t* volatile function_listener = listener_of(function_wrapper);
+
+    counting_pointer static_wrapper(factory);
+    const listener_t* volatile static_listener = listener_of(static_wrapper);
+
+    if(function_listener == nullptr || static_listener == nullptr) {
+        cerr << "no listener installed" << endl;
+        return 1;
+    }
+
+    double function_event = measure_ns(events, [&]() {
+        dispatch(function_listener, function_wrapper.wl_obj(), events);
+    });
+
+    double static_event = measure_ns(events, [&]() {
+        dispatch(static_listener, static_wrapper.wl_obj(), events);
+    });
+
+    double function_registration = measure_ns(registrations, [&]() {
+        for(uint64_t i = 0; i < registrations; ++i) {
+            function_wrapper.set_motion_handler(bind(&motion_counter::motion, &function_counter, _1, _2, _3));
+        }
+    });
+
+    if(function_counter.events != events || static_wrapper.counter.events != events) {
+        cerr << "event count mismatch" << endl;
+        return 1;
+    }
+
+    cout << "handler model    ns/event    ns/registration" << endl;
+    cout << "function         " << function_event << "    " << function_registration << endl;
+    cout << "static           " << static_event << "    0 (compile time)" << endl;
+    cout << "checksum " << function_counter.distance + static_wrapper.counter.distance << endl;
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    fake_compositor peer;
+    if(!peer.valid()) {
+        cerr << "socketpair failed" << endl;
+        return 1;
+    }
+
+    wl_display* display = wl_display_connect_to_fd(peer.client_fd());
+    if(!display) {
+        cerr << "wl_display_connect_to_fd failed" << endl;
+        return 1;
+    }
+
+    int result = run(display);
+
+    wl_display_disconnect(display);
+
+    return result;
+}
@@ -0,0 +1,163 @@
+
+#ifndef _WLCPP_BENCH_HARNESS_HPP_
+#define _WLCPP_BENCH_HARNESS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace wlcpp {
+
+/* Number of allocations through operator new so far. The counting operators
+ * are defined in allocation_counter.cpp, which only the benchmarks that report
+ * allocations link. This covers wrappers, but not the wl_proxy objects
+ * allocated by libwayland. */
+std::uint64_t allocations();
+
+/* Plays the compositor at the other end of a socket pair. A display is
+ * connected to client_fd(), which it owns from then on. Benchmarks read the
+ * requests one at a time and queue events, which send_events() writes at
+ * once, or discard everything on a thread of their own. Nothing is allocated
+ * while doing so, so allocations() only counts the client. */
+class fake_compositor {
+public:
+    static const std::uint32_t display_id = 1;
+    static const std::uint32_t callback_done_opcode = 0;
+    static const std::uint32_t display_delete_id_opcode = 1;
+
+    fake_compositor()
+        : _event_count(0) {
+        if(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, _fds) < 0) {
+            _fds[0] = -1;
+            _fds[1] = -1;
+        }
+    }
+
+    fake_compositor(const fake_compositor&) = delete;
+
+    ~fake_compositor() {
+        if(_fds[1] >= 0) {
+            close(_fds[1]);
+        }
+    }
+
+    fake_compositor& operator=(const fake_compositor&) = delete;
+
+    bool valid() const {
+        return _fds[0] >= 0;
+    }
+
+    int client_fd() const {
+        return _fds[0];
+    }
+
+    int server_fd() const {
+        return _fds[1];
+    }
+
+    /* Read the next request. Fails if the client is gone or the request is
+     * larger than max_request_words. */
+    bool read_request() {
+        if(!read_all(_request, 8)) {
+            return false;
+        }
+        std::uint32_t size = request_size();
+        return size >= 8 && size <= sizeof(_request) && read_all(_request + 2, size - 8);
+    }
+
+    std::uint32_t request_object() const {
+        return _request[0];
+    }
+
+    std::uint32_t request_opcode() const {
+        return _request[1] & 0xffff;
+    }
+
+    /* Size of the request in bytes, including the header */
+    std::uint32_t request_size() const {
+        return _request[1] >> 16;
+    }
+
+    /* Argument i of the request as a 32 bit word */
+    std::uint32_t request_arg(std::size_t i) const {
+        return _request[2 + i];
+    }
+
+    /* Queue an event whose arguments are 32 bit words. Fails if the queue is
+     * full. */
+    bool queue_event(std::uint32_t object, std::uint32_t opcode, const std::uint32_t* args, std::size_t arg_count) {
+        if(_event_count + 2 + arg_count > max_event_words) {
+            return false;
+        }
+        _events[_event_count++] = object;
+        _events[_event_count++] = static_cast<std::uint32_t>((8 + 4 * arg_count) << 16) | opcode;
+        for(std::size_t i = 0; i < arg_count; ++i) {
+            _events[_event_count++] = args[i];
+        }
+        return true;
+    }
+
+    /* Queue wl_callback.done for a callback, followed by the
+     * wl_display.delete_id which releases its id. */
+    bool queue_done(std::uint32_t callback_id, std::uint32_t serial = 0) {
+        return queue_event(callback_id, callback_done_opcode, &serial, 1) && queue_delete_id(callback_id);
+    }
+
+    bool queue_delete_id(std::uint32_t id) {
+        return queue_event(display_id, display_delete_id_opcode, &id, 1);
+    }
+
+    /* Write all queued events in one go */
+    bool send_events() {
+        std::size_t size = _event_count * sizeof(std::uint32_t);
+        _event_count = 0;
+        return write(_fds[1], _events, size) == static_cast<ssize_t>(size);
+    }
+
+    /* Write words which are already encoded as events */
+    bool send(const std::uint32_t* words, std::size_t count) {
+        std::size_t size = count * sizeof(std::uint32_t);
+        return write(_fds[1], words, size) == static_cast<ssize_t>(size);
+    }
+
+    /* Read and discard requests until the client closes its end, adding the
+     * number of bytes read to received if given. */
+    void discard(std::atomic<std::uint64_t>* received = nullptr) {
+        char buffer[65536];
+        ssize_t length;
+        while((length = read(_fds[1], buffer, sizeof(buffer))) > 0) {
+            if(received != nullptr) {
+                *received += length;
+            }
+        }
+    }
+
+private:
+    static const std::size_t max_request_words = 16;
+    static const std::size_t max_event_words = 256;
+
+    bool read_all(std::uint32_t* buffer, std::size_t size) {
+        char* data = reinterpret_cast<char*>(buffer);
+        while(size > 0) {
+            ssize_t length = read(_fds[1], data, size);
+            if(length <= 0) {
+                return false;
+            }
+            data += length;
+            size -= length;
+        }
+        return true;
+    }
+
+    int _fds[2];
+    std::uint32_t _request[max_request_words];
+    std::uint32_t _events[max_event_words];
+    std::size_t _event_count;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_BENCH_HARNESS_HPP_
+
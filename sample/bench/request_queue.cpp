@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+#include "harness.hpp"
+#include "../request_queue.hpp"
+#include "../generated/display.hpp"
+#include "../generated/surface.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+// Compares worker threads which send wl_surface.damage and wl_surface.commit
+// directly, each request taking the display mutex, with workers which push the
+// requests into a request_queue that a display thread drains before it
+// flushes. A fake_compositor discards the requests on a thread of its own.
+// libwayland fails if its buffer is full while the socket is, so the requests
+// are sent in rounds which fit into the socket buffer, and only the time the
+// workers take is measured. The number of bytes received checks that every
+// request was sent exactly once.
+
+namespace {
+
+typedef chrono::steady_clock clock_type;
+
+const uint64_t frame_size = 24 + 8;
+const unsigned threads = 4;
+const uint64_t frames_per_round = 250;
+const uint64_t rounds = 200;
+
+atomic<uint64_t> received(0);
+
+// Runs one round on every worker and returns the time from the first worker
+// starting to the last one finishing.
+template <typename Frame>
+double run_round(Frame frame) {
+    vector<clock_type::time_point> start(threads);
+    vector<clock_type::time_point> end(threads);
+    vector<thread> workers;
+    for(unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back([&, i]() {
+            start[i] = clock_type::now();
+            for(uint64_t j = 0; j < frames_per_round; ++j) {
+                frame();
+            }
+            end[i] = clock_type::now();
+        });
+    }
+    for(thread& t : workers) {
+        t.join();
+    }
+    return chrono::duration<double, nano>(*max_element(end.begin(), end.end()) - *min_element(start.begin(), start.end())).count();
+}
+
+void wait_until_received(uint64_t bytes) {
+    while(received.load() < bytes) {
+        this_thread::yield();
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const uint64_t round_bytes = threads * frames_per_round * frame_size;
+    const uint64_t requests = 2 * threads * frames_per_round * rounds;
+
+    fake_compositor peer;
+    if(!peer.valid()) {
+        cerr << "socketpair failed" << endl;
+        return 1;
+    }
+
+    display d(peer.client_fd());
+    if(!d.valid()) {
+        cerr << "wl_display_connect_to_fd failed" << endl;
+        return 1;
+    }
+    surface s(d);
+    thread peer_thread([&peer]() {
+        peer.discard(&received);
+    });
+
+    double direct_ns = 0.0;
+    for(uint64_t round = 1; round <= rounds; ++round) {
+        direct_ns += run_round([&]() {
+            s.damage(0, 0, 64, 64);
+            s.commit();
+        });
+        d.flush();
+        wait_until_received(round * round_bytes);
+    }
+
+    request_queue queue;
+    atomic<bool> running(true);
+    thread display_thread([&]() {
+        pollfd pfd = { queue.get_fd(), POLLIN, 0 };
+        while(running.load()) {
+            poll(&pfd, 1, 1);
+            queue.drain();
+            d.flush();
+        }
+    });
+
+    double queued_ns = 0.0;
+    for(uint64_t round = 1; round <= rounds; ++round) {
+        queued_ns += run_round([&]() {
+            while(!queue.push(s, surface::damage_args{ 0, 0, 64, 64 })) {
+                this_thread::yield();
+            }
+            while(!queue.push(s, surface::commit_args())) {
+                this_thread::yield();
+            }
+        });
+        wait_until_received((rounds + round) * round_bytes);
+    }
+    running = false;
+    display_thread.join();
+
+    shutdown(peer.client_fd(), SHUT_WR);
+    peer_thread.join();
+
+    if(received.load() != 2 * rounds * round_bytes) {
+        cerr << "received " << received.load() << " bytes instead of " << 2 * rounds * round_bytes << endl;
+        return 1;
+    }
+
+    const request_queue_stats stats = queue.stats();
+    cout << threads << " threads, " << requests << " requests per mode" << endl;
+    cout << "direct           " << direct_ns / requests << " ns/request" << endl;
+    cout << "request_queue    " << queued_ns / requests << " ns/request" << endl;
+    cout << "drains           " << stats.drains << ", average depth " << static_cast<double>(stats.requests) / stats.drains << ", max depth " << stats.max_depth << endl;
+    cout << "latency          " << stats.total_latency_ns / stats.requests << " ns average, " << stats.max_latency_ns << " ns max" << endl;
+    cout << "rejected pushes  " << stats.rejected << endl;
+
+    return 0;
+}
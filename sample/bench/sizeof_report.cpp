@@ -0,0 +1,50 @@
+#include <iostream>
+#include "inline_wayland.hpp"
+#include "sparse_wayland.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+// Prints the size of every class generated with --handler-storage inline and
+// sparse. The build generates the core protocol once for each storage, with
+// delegate handlers and the class prefixes inline_ and sparse_, so both can be
+// compared in one program.
+
+template <typename Inline, typename Sparse>
+static void report(const char* name) {
+    cout.width(24);
+    cout << left << name;
+    cout.width(8);
+    cout << sizeof(Inline) << sizeof(Sparse) << endl;
+}
+
+int main(int argc, char* argv[]) {
+    cout.width(24);
+    cout << left << "class";
+    cout.width(8);
+    cout << "inline" << "sparse" << endl;
+    report<proxy, proxy>("proxy");
+    report<inline_buffer, sparse_buffer>("buffer");
+    report<inline_callback, sparse_callback>("callback");
+    report<inline_compositor, sparse_compositor>("compositor");
+    report<inline_data_device, sparse_data_device>("data_device");
+    report<inline_data_device_manager, sparse_data_device_manager>("data_device_manager");
+    report<inline_data_offer, sparse_data_offer>("data_offer");
+    report<inline_data_source, sparse_data_source>("data_source");
+    report<inline_display, sparse_display>("display");
+    report<inline_keyboard, sparse_keyboard>("keyboard");
+    report<inline_output, sparse_output>("output");
+    report<inline_pointer, sparse_pointer>("pointer");
+    report<inline_region, sparse_region>("region");
+    report<inline_registry, sparse_registry>("registry");
+    report<inline_seat, sparse_seat>("seat");
+    report<inline_shell, sparse_shell>("shell");
+    report<inline_shell_surface, sparse_shell_surface>("shell_surface");
+    report<inline_shm, sparse_shm>("shm");
+    report<inline_shm_pool, sparse_shm_pool>("shm_pool");
+    report<inline_subcompositor, sparse_subcompositor>("subcompositor");
+    report<inline_subsurface, sparse_subsurface>("subsurface");
+    report<inline_surface, sparse_surface>("surface");
+    report<inline_touch, sparse_touch>("touch");
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../proxy.hpp"
+#include "../bench/harness.hpp"
+#include "../generated/compositor.hpp"
+#include "../generated/display.hpp"
+#include "../generated/region.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+// Creates and destroys regions on two threads of one display: the display
+// thread through the compositor and a worker thread through a
+// proxy_wrapper<compositor> with its own queue. Both enter their regions into
+// the object table of the display and look them up again. The check is built
+// with -fsanitize=thread, which reports any unsynchronized access to the
+// table. A fake_compositor discards the requests on a thread of its own.
+
+namespace {
+
+const unsigned rounds = 500;
+const unsigned regions_per_round = 8;
+
+// libwayland fails if its buffer is full while the socket is, so requests
+// are flushed after every round.
+bool flush(display& d) {
+    while(d.flush() < 0) {
+        if(errno != EAGAIN) {
+            return false;
+        }
+        this_thread::yield();
+    }
+    return true;
+}
+
+bool create_regions(display& d, compositor& c) {
+    for(unsigned i = 0; i < rounds; ++i) {
+        vector<region> regions;
+        for(unsigned j = 0; j < regions_per_round; ++j) {
+            regions.push_back(c.create_region());
+        }
+        for(region& r : regions) {
+            if(d.find(r.get_id()) != &r) {
+                cerr << "region " << r.get_id() << " not found" << endl;
+                return false;
+            }
+        }
+        regions.clear();
+        if(!flush(d)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    fake_compositor peer;
+    if(!peer.valid()) {
+        cerr << "socketpair failed" << endl;
+        return 1;
+    }
+
+    thread server([&peer]() {
+        peer.discard();
+    });
+
+    // Disconnecting the display closes the client end, which ends discard().
+    bool result;
+    {
+        display d(peer.client_fd());
+        if(!d.valid()) {
+            cerr << "wl_display_connect_to_fd failed" << endl;
+            return 1;
+        }
+        compositor c(d);
+        event_queue queue = d.create_queue();
+
+        atomic<bool> worker_result(false);
+        thread worker([&]() {
+            proxy_wrapper<compositor> wrapper(c, queue);
+            worker_result = create_regions(d, *wrapper);
+        });
+
+        result = create_regions(d, c);
+        worker.join();
+        result = result && worker_result && d.find(c.get_id()) == &c;
+    }
+
+    server.join();
+
+    cout << (result ? "object table ok" : "object table failed") << endl;
+    return result ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#ifndef _WLCPP_DELEGATE_HPP_
+#define _WLCPP_DELEGATE_HPP_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef WLCPP_DELEGATE_SIZE
+#define WLCPP_DELEGATE_SIZE (4 * sizeof(void*))
+#endif
+
+namespace wlcpp {
+
+template <typename Signature, std::size_t Size = WLCPP_DELEGATE_SIZE>
+class delegate;
+
+/** \brief Move-only callable wrapper which never allocates
+ *
+ *  The callable is always stored inside the delegate. Callables larger than Size
+ *  bytes are rejected at compile time. Size defaults to WLCPP_DELEGATE_SIZE,
+ *  which can be defined before including this header.
+ */
+template <typename R, typename... Args, std::size_t Size>
+class delegate<R (Args...), Size> {
+public:
+    delegate()
+        : _invoke(nullptr),
+          _manage(nullptr) {
+    }
+
+    delegate(std::nullptr_t)
+        : delegate() {
+    }
+
+    template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, delegate>::value>::type>
+    delegate(F&& f)
+        : delegate() {
+        using T = typename std::decay<F>::type;
+        static_assert(sizeof(T) <= Size, "callable does not fit into the delegate, increase WLCPP_DELEGATE_SIZE");
+        static_assert(alignof(T) <= alignof(storage_t), "callable is over-aligned for the delegate");
+
+        if(!is_null(f)) {
+            new (&_storage) T(std::forward<F>(f));
+            _invoke = &invoke<T>;
+            _manage = &manage<T>;
+        }
+    }
+
+    delegate(const delegate&) = delete;
+
+    delegate(delegate&& rhs)
+        : delegate() {
+        move_from(rhs);
+    }
+
+    ~delegate() {
+        reset();
+    }
+
+    delegate& operator=(const delegate&) = delete;
+
+    delegate& operator=(delegate&& rhs) {
+        if(this != &rhs) {
+            reset();
+            move_from(rhs);
+        }
+        return *this;
+    }
+
+    explicit operator bool() const {
+        return _invoke != nullptr;
+    }
+
+    R operator()(Args... args) const {
+        return _invoke(&_storage, std::forward<Args>(args)...);
+    }
+
+    void reset() {
+        if(_manage) {
+            _manage(&_storage, nullptr);
+            _invoke = nullptr;
+            _manage = nullptr;
+        }
+    }
+
+private:
+    using storage_t = typename std::aligned_storage<Size, alignof(std::max_align_t)>::type;
+
+    /* Moves the callable from src to dst and destroys src. If dst is nullptr, src
+     * is only destroyed. */
+    using manage_t = void (*)(void* src, void* dst);
+
+    /* Callables which can be tested as bool, like pointers or std::function,
+     * are null if they test false. Other callables are never null. */
+    template <typename T>
+    static bool is_null(const T& f) {
+        return is_null(f, 0);
+    }
+
+    template <typename T>
+    static auto is_null(const T& f, int) -> decltype(static_cast<bool>(f)) {
+        return !static_cast<bool>(f);
+    }
+
+    template <typename T>
+    static bool is_null(const T&, long) {
+        return false;
+    }
+
+    template <typename T>
+    static R invoke(void* storage, Args... args) {
+        return (*static_cast<T*>(storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static void manage(void* src, void* dst) {
+        T* src_callable = static_cast<T*>(src);
+        if(dst) {
+            new (dst) T(std::move(*src_callable));
+        }
+        src_callable->~T();
+    }
+
+    void move_from(delegate& rhs) {
+        if(rhs._manage) {
+            rhs._manage(&rhs._storage, &_storage);
+            _invoke = rhs._invoke;
+            _manage = rhs._manage;
+            rhs._invoke = nullptr;
+            rhs._manage = nullptr;
+        }
+    }
+
+    R (*_invoke)(void*, Args...);
+    manage_t _manage;
+    mutable storage_t _storage;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_DELEGATE_HPP_
@@ -0,0 +1,104 @@
+
+#include "destruction_manager.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+destruction_manager::destruction_manager(display& d)
+    : _display(d) {
+}
+
+destruction_manager::~destruction_manager() {
+    // Objects are destroyed without waiting for their ids. libwayland keeps
+    // a placeholder for every id until its delete_id arrives.
+    for(entry& e : _destroyed) {
+        if(e.obj != nullptr && e.k->destructor_opcode >= 0) {
+            wl_proxy_marshal_array(e.obj, e.k->destructor_opcode, nullptr);
+        }
+    }
+    release(_destroyed);
+    for(batch& b : _batches) {
+        release(b.entries);
+    }
+    _batches.clear();
+
+    // Released wrappers are empty. Wrappers which are still adopted send
+    // their destructor request from their own destructor.
+    for(auto& k : _kinds) {
+        for(proxy* wrapper : k.second.wrappers) {
+            k.second.destroy(wrapper);
+        }
+    }
+}
+
+size_t destruction_manager::flush() {
+    if(_destroyed.empty()) {
+        return 0;
+    }
+
+    size_t sent = 0;
+    for(entry& e : _destroyed) {
+        if(e.obj == nullptr) {
+            continue;
+        }
+
+        if(e.k->destructor_opcode < 0) {
+            wl_proxy_destroy(e.obj);
+            e.obj = nullptr;
+            continue;
+        }
+
+        uint32_t opcode = e.k->destructor_opcode;
+        wl_proxy_marshal_array(e.obj, opcode, nullptr);
+        if(proxy::active_batch != nullptr) {
+            proxy::add_to_batch(e.k->interface->methods[opcode], nullptr);
+        }
+        ++sent;
+    }
+
+    _batches.emplace_back();
+    batch& b = _batches.back();
+    b.entries.swap(_destroyed);
+    _destroyed.swap(_spare);
+    b.barrier = sync_future(_display);
+    b.barrier.then([this](uint32_t) {
+        // The done events of the barriers arrive in the order in which the
+        // barriers were sent. Removing the batch destroys the running future,
+        // which sync_future allows.
+        vector<entry>& entries = _batches.front().entries;
+        release(entries);
+        if(entries.capacity() > _spare.capacity()) {
+            _spare.swap(entries);
+        }
+        _batches.pop_front();
+    });
+
+    return sent;
+}
+
+size_t destruction_manager::pending() const {
+    size_t result = _destroyed.size();
+    for(const batch& b : _batches) {
+        result += b.entries.size();
+    }
+    return result;
+}
+
+size_t destruction_manager::free_slots() const {
+    size_t result = 0;
+    for(const auto& k : _kinds) {
+        result += k.second.free.size();
+    }
+    return result;
+}
+
+void destruction_manager::release(vector<entry>& entries) {
+    for(entry& e : entries) {
+        if(e.obj != nullptr) {
+            wl_proxy_destroy(e.obj);
+        }
+        e.k->free.push_back(e.wrapper);
+    }
+    entries.clear();
+}
+
@@ -0,0 +1,139 @@
+
+#ifndef _WLCPP_DESTRUCTION_MANAGER_HPP_
+#define _WLCPP_DESTRUCTION_MANAGER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "proxy.hpp"
+#include "sync_future.hpp"
+#include "generated/display.hpp"
+
+namespace wlcpp {
+
+/* Owns wrappers whose destruction is deferred until the compositor released
+ * their ids.
+ *
+ * adopt() moves a wrapper into storage owned by the manager, and destroy()
+ * ends its use: the wrapper is invalidated and its handlers are cleared at
+ * once, but its wl_proxy stays alive, so events which are still queued for it
+ * reach an empty wrapper. flush() sends the destructor requests of all
+ * wrappers destroyed since the last flush in one batch, followed by one
+ * wl_display.sync. The compositor sends wl_display.delete_id for every
+ * destroyed id before the done event of that sync, and libwayland dispatches
+ * it first, so once done arrived the ids are free. Only then the wl_proxy
+ * objects are destroyed and the wrappers go to a free list of their C++
+ * type, from which adopt() takes them again.
+ *
+ * libwayland handles delete_id itself and does not pass it on, so the sync is
+ * how the manager learns about it. Objects without a destructor request, like
+ * wl_callback, are destroyed locally by flush().
+ *
+ * Every wrapper allocated by adopt() is deleted with the manager, including
+ * those which were never passed to destroy().
+ */
+class destruction_manager {
+public:
+    explicit destruction_manager(display& d);
+    destruction_manager(const destruction_manager&) = delete;
+    ~destruction_manager();
+
+    destruction_manager& operator=(const destruction_manager&) = delete;
+
+    /** \brief Move obj into a wrapper owned by the manager
+     *
+     *  The wrapper is taken from the free list of its type if possible.
+     *  It stays at the same address until it is passed to destroy().
+     */
+    template <typename T>
+    T& adopt(T&& obj) {
+        kind& k = get_kind<T>();
+        if(k.free.empty()) {
+            T* wrapper = new T(std::move(obj));
+            k.wrappers.push_back(wrapper);
+            return *wrapper;
+        }
+
+        T* wrapper = static_cast<T*>(k.free.back());
+        k.free.pop_back();
+        *wrapper = std::move(obj);
+        return *wrapper;
+    }
+
+    /** \brief Destroy a wrapper returned by adopt(), as the same type T
+     *
+     *  The destructor request is sent by the next flush(). The wrapper must
+     *  not be used anymore.
+     */
+    template <typename T>
+    void destroy(T& wrapper) {
+        wl_proxy* obj = wrapper.managed() ? wrapper.wl_obj() : nullptr;
+        wrapper.invalidate();
+        // Clears the handlers. The user data of obj still points to wrapper.
+        wrapper = T();
+        _destroyed.push_back(entry{ obj, &wrapper, &get_kind<T>() });
+    }
+
+    /** \brief Send the destructor requests of all wrappers destroyed since the
+     *  last call, followed by one sync. Call before flushing the display.
+     *  @return Number of destructor requests sent
+     */
+    std::size_t flush();
+
+    /** \brief Number of wrappers destroyed, but not released yet */
+    std::size_t pending() const;
+
+    /** \brief Number of wrappers in the free lists */
+    std::size_t free_slots() const;
+
+private:
+    struct kind {
+        const wl_interface* interface;
+        std::int32_t destructor_opcode;
+        void (*destroy)(proxy* wrapper);
+        // All wrappers allocated for the interface, whether adopted or free.
+        std::vector<proxy*> wrappers;
+        std::vector<proxy*> free;
+    };
+
+    struct entry {
+        wl_proxy* obj;
+        proxy* wrapper;
+        kind* k;
+    };
+
+    struct batch {
+        sync_future barrier;
+        std::vector<entry> entries;
+    };
+
+    template <typename T>
+    kind& get_kind() {
+        // Keyed by the C++ type, because several types can share one
+        // wl_interface, like the classes derived from basic_static_<class>.
+        auto it = _kinds.find(std::type_index(typeid(T)));
+        if(it == _kinds.end()) {
+            kind k = { &T::interface, T::destructor_opcode, &interface_info::destroy_wrapper<T>, std::vector<proxy*>(), std::vector<proxy*>() };
+            it = _kinds.insert(std::make_pair(std::type_index(typeid(T)), std::move(k))).first;
+        }
+        return it->second;
+    }
+
+    void release(std::vector<entry>& entries);
+
+    display& _display;
+    std::unordered_map<std::type_index, kind> _kinds;
+    std::vector<entry> _destroyed;
+    // Empty, keeps the capacity of released batches for _destroyed.
+    std::vector<entry> _spare;
+    std::deque<batch> _batches;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_DESTRUCTION_MANAGER_HPP_
+
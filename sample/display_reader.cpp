@@ -0,0 +1,109 @@
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "display_reader.hpp"
+#include "generated/display.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+display_reader::display_reader(display& d)
+    : _display(d),
+      _stopped(false) {
+}
+
+int display_reader::run(event_queue& queue) {
+    int wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if(wake_fd < 0) {
+        return -1;
+    }
+
+    {
+        lock_guard<mutex> lock(_mutex);
+        _wake_fds.push_back(wake_fd);
+    }
+
+    int result = 0;
+    while(!stopped() && result >= 0) {
+        result = read_once(queue, wake_fd);
+    }
+
+    {
+        lock_guard<mutex> lock(_mutex);
+        _wake_fds.erase(find(_wake_fds.begin(), _wake_fds.end(), wake_fd));
+    }
+    close(wake_fd);
+
+    return result < 0 ? -1 : 0;
+}
+
+void display_reader::wake() {
+    lock_guard<mutex> lock(_mutex);
+    uint64_t value = 1;
+    for(int wake_fd : _wake_fds) {
+        if(write(wake_fd, &value, sizeof(value)) < 0) {
+            continue;
+        }
+    }
+}
+
+void display_reader::stop() {
+    _stopped = true;
+    wake();
+}
+
+bool display_reader::stopped() const {
+    return _stopped;
+}
+
+int display_reader::read_once(event_queue& queue, int wake_fd) {
+    while(_display.prepare_read_queue(queue) != 0) {
+        if(_display.dispatch_queue_pending(queue) < 0) {
+            return -1;
+        }
+    }
+
+    // If the socket is full, the rest of the requests is sent once it becomes
+    // writable, otherwise a worker waiting for a reply could wait forever.
+    short display_events = POLLIN;
+    if(_display.flush() < 0) {
+        if(errno != EAGAIN) {
+            _display.cancel_read();
+            return -1;
+        }
+        display_events |= POLLOUT;
+    }
+
+    pollfd fds[2] = {
+        { _display.get_fd(), display_events, 0 },
+        { wake_fd, POLLIN, 0 }
+    };
+    int ready = poll(fds, 2, -1);
+
+    // Every worker which prepared has to read or cancel before libwayland
+    // reads, so a woken worker must not keep the others waiting.
+    if(ready > 0 && (fds[0].revents & (POLLIN | POLLERR | POLLHUP))) {
+        if(_display.read_events() < 0) {
+            return -1;
+        }
+    }
+    else {
+        _display.cancel_read();
+        if(ready < 0 && errno != EINTR) {
+            return -1;
+        }
+    }
+
+    if(ready > 0 && (fds[1].revents & POLLIN)) {
+        uint64_t value;
+        if(read(wake_fd, &value, sizeof(value)) < 0 && errno != EAGAIN) {
+            return -1;
+        }
+    }
+
+    return _display.dispatch_queue_pending(queue);
+}
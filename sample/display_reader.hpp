@@ -0,0 +1,59 @@
+
+#ifndef _WLCPP_DISPLAY_READER_HPP_
+#define _WLCPP_DISPLAY_READER_HPP_
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "event_queue.hpp"
+
+namespace wlcpp {
+
+class display;
+
+/* Reads the events of a display on several threads, each of which dispatches
+ * its own event queue, e.g. one for input and one for rendering.
+ *
+ * Every worker runs the read protocol of libwayland against its queue:
+ * prepare_read_queue() (dispatching what is already queued), flush(), poll(),
+ * then read_events() or cancel_read() and dispatch_queue_pending(). If the
+ * socket was full, poll() also waits until it is writable, and the next
+ * iteration sends the rest. All workers waiting for events poll the same
+ * socket, so they all wake up when it becomes readable. libwayland lets the
+ * last of them do the read and then releases the others, which dispatch their
+ * queues in parallel. Every worker also polls its own eventfd, through which
+ * stop() and wake() interrupt the wait.
+ */
+class display_reader {
+public:
+    explicit display_reader(display& d);
+    display_reader(const display_reader&) = delete;
+
+    display_reader& operator=(const display_reader&) = delete;
+
+    /* Dispatch queue on the calling thread until stop() is called. Returns 0
+     * after stop() or -1 on error. */
+    int run(event_queue& queue);
+
+    /* Wake up all workers, e.g. after work for them was queued by other
+     * means than events. */
+    void wake();
+
+    /* Make run() return on all threads. */
+    void stop();
+
+    bool stopped() const;
+
+private:
+    int read_once(event_queue& queue, int wake_fd);
+
+    display& _display;
+    std::mutex _mutex;
+    std::vector<int> _wake_fds;
+    std::atomic<bool> _stopped;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_DISPLAY_READER_HPP_
+
@@ -0,0 +1,229 @@
+
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include "event_loop.hpp"
+#include "request_batch.hpp"
+#include "generated/display.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+namespace {
+
+const int max_events = 32;
+
+timespec to_timespec(chrono::nanoseconds duration) {
+    timespec result;
+    result.tv_sec = static_cast<time_t>(duration.count() / 1000000000);
+    result.tv_nsec = static_cast<long>(duration.count() % 1000000000);
+    return result;
+}
+
+} // namespace
+
+event_loop::event_loop(display& d)
+    : _display(d),
+      _epoll_fd(epoll_create1(EPOLL_CLOEXEC)),
+      _want_output(false),
+      _stopped(false) {
+    // The display is the only source without a source object.
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    if(_epoll_fd >= 0) {
+        epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _display.get_fd(), &event);
+    }
+}
+
+event_loop::~event_loop() {
+    for(auto& entry : _sources) {
+        if(entry.second->timer) {
+            close(entry.first);
+        }
+    }
+    if(_epoll_fd >= 0) {
+        close(_epoll_fd);
+    }
+}
+
+bool event_loop::add_fd(int fd, uint32_t events, fd_handler handler) {
+    unique_ptr<source> s(new source());
+    s->fd = fd;
+    s->timer = false;
+    s->on_fd = move(handler);
+    return add_source(move(s), events);
+}
+
+void event_loop::remove_fd(int fd) {
+    remove_source(fd);
+}
+
+int event_loop::add_timer(chrono::nanoseconds delay, chrono::nanoseconds interval, timer_handler handler) {
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if(fd < 0) {
+        return -1;
+    }
+
+    unique_ptr<source> s(new source());
+    s->fd = fd;
+    s->timer = true;
+    s->on_timer = move(handler);
+    if(!set_timer(fd, delay, interval) || !add_source(move(s), EPOLLIN | EPOLLET)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool event_loop::set_timer(int timer, chrono::nanoseconds delay, chrono::nanoseconds interval) {
+    itimerspec spec;
+    spec.it_value = to_timespec(delay);
+    spec.it_interval = to_timespec(interval);
+    return timerfd_settime(timer, 0, &spec, nullptr) == 0;
+}
+
+void event_loop::remove_timer(int timer) {
+    if(_sources.count(timer) > 0) {
+        remove_source(timer);
+        close(timer);
+    }
+}
+
+int event_loop::dispatch(int timeout) {
+    while(_display.prepare_read() != 0) {
+        if(_display.dispatch_pending() < 0) {
+            return -1;
+        }
+    }
+
+    if(flush(true) < 0) {
+        _display.cancel_read();
+        return -1;
+    }
+
+    epoll_event events[max_events];
+    int count = epoll_wait(_epoll_fd, events, max_events, timeout);
+    if(count < 0) {
+        _display.cancel_read();
+        return errno == EINTR ? 0 : -1;
+    }
+
+    uint32_t display_events = 0;
+    for(int i = 0; i < count; ++i) {
+        if(events[i].data.ptr == nullptr) {
+            display_events = events[i].events;
+        }
+    }
+
+    if(display_events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+        if(_display.read_events() < 0) {
+            return -1;
+        }
+    }
+    else {
+        _display.cancel_read();
+    }
+
+    if((display_events & EPOLLOUT) && flush(false) < 0) {
+        return -1;
+    }
+
+    if(_display.dispatch_pending() < 0) {
+        return -1;
+    }
+
+    // Sources removed by handlers are kept until the end of the iteration,
+    // because later events may still refer to them.
+    for(int i = 0; i < count; ++i) {
+        source* s = static_cast<source*>(events[i].data.ptr);
+        if(s == nullptr || s->fd < 0) {
+            continue;
+        }
+
+        if(s->timer) {
+            uint64_t expirations = 0;
+            if(read(s->fd, &expirations, sizeof(expirations)) == sizeof(expirations) && s->on_timer) {
+                s->on_timer(expirations);
+            }
+        }
+        else if(s->on_fd) {
+            s->on_fd(events[i].events);
+        }
+    }
+    _removed.clear();
+
+    return count;
+}
+
+int event_loop::run() {
+    _stopped = false;
+    while(!_stopped) {
+        if(dispatch() < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void event_loop::stop() {
+    _stopped = true;
+}
+
+bool event_loop::add_source(unique_ptr<source> s, uint32_t events) {
+    epoll_event event = {};
+    event.events = events;
+    event.data.ptr = s.get();
+    if(epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, s->fd, &event) < 0) {
+        return false;
+    }
+    _sources[s->fd] = move(s);
+    return true;
+}
+
+void event_loop::remove_source(int fd) {
+    auto it = _sources.find(fd);
+    if(it == _sources.end()) {
+        return;
+    }
+
+    epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    it->second->fd = -1;
+    _removed.push_back(move(it->second));
+    _sources.erase(it);
+}
+
+// Flushes the display, through the active request_batch if there is one.
+// Before waiting (idle), a batch which does not flush on idle keeps its
+// requests. If the socket is full, the display is also watched for EPOLLOUT
+// until the rest could be sent.
+int event_loop::flush(bool idle) {
+    request_batch* batch = proxy::active_batch;
+    int result;
+    if(batch == nullptr) {
+        result = _display.flush();
+    }
+    else if(idle) {
+        if(!batch->policy().on_idle) {
+            return 0;
+        }
+        result = batch->idle();
+    }
+    else {
+        result = batch->flush();
+    }
+    bool want_output = result < 0 && errno == EAGAIN;
+    if(result < 0 && !want_output) {
+        return -1;
+    }
+
+    if(want_output != _want_output) {
+        epoll_event event = {};
+        event.events = want_output ? EPOLLIN | EPOLLOUT : EPOLLIN;
+        event.data.ptr = nullptr;
+        epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, _display.get_fd(), &event);
+        _want_output = want_output;
+    }
+    return 0;
+}
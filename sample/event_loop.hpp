@@ -0,0 +1,110 @@
+
+#ifndef _WLCPP_EVENT_LOOP_HPP_
+#define _WLCPP_EVENT_LOOP_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include "delegate.hpp"
+
+namespace wlcpp {
+
+class display;
+
+/* Event loop for a display, timers and other file descriptors, based on epoll.
+ *
+ * dispatch() runs the read protocol of libwayland for the default queue around
+ * epoll_wait(): prepare_read() (dispatching what is already queued), flush(),
+ * epoll_wait(), then read_events() or cancel_read() and dispatch_pending().
+ * Events are read as soon as the display becomes readable, and when nothing
+ * happens, epoll_wait() is the only system call.
+ *
+ * If a request_batch is active on the calling thread, the loop flushes through
+ * it: idle() before waiting, so the flush_policy of the batch decides whether
+ * to flush, and flush() when the socket becomes writable again. The batch then
+ * counts every flush. Without a batch, the display is flushed directly. Timers are timerfds and,
+ * like other file descriptors, are registered once and never polled.
+ *
+ * The display is watched level-triggered, because libwayland reads at most one
+ * buffer per read_events(). Timers are edge-triggered; other file descriptors
+ * are edge-triggered if EPOLLET is passed to add_fd().
+ */
+class event_loop {
+public:
+    /** \brief Called with the ready epoll events of a file descriptor */
+    using fd_handler = delegate<void (std::uint32_t events)>;
+
+    /** \brief Called with the number of expirations of a timer since the last call */
+    using timer_handler = delegate<void (std::uint64_t expirations)>;
+
+    explicit event_loop(display& d);
+    event_loop(const event_loop&) = delete;
+    ~event_loop();
+
+    event_loop& operator=(const event_loop&) = delete;
+
+    /** \brief Watch a file descriptor
+     *  @param fd File descriptor, which is not owned by the loop
+     *  @param events epoll events, e.g. EPOLLIN or EPOLLIN | EPOLLET
+     *  @param handler Called when fd is ready
+     *  @return false if epoll_ctl failed
+     */
+    bool add_fd(int fd, std::uint32_t events, fd_handler handler);
+
+    /** \brief Stop watching a file descriptor */
+    void remove_fd(int fd);
+
+    /** \brief Start a timer
+     *  @param delay Time until the first expiration
+     *  @param interval Time between further expirations, 0 for a one-shot timer
+     *  @param handler Called after expirations
+     *  @return Id of the timer or -1 on error
+     */
+    int add_timer(std::chrono::nanoseconds delay, std::chrono::nanoseconds interval, timer_handler handler);
+
+    /** \brief Restart a timer, a delay of 0 disarms it */
+    bool set_timer(int timer, std::chrono::nanoseconds delay, std::chrono::nanoseconds interval);
+
+    /** \brief Remove a timer */
+    void remove_timer(int timer);
+
+    /** \brief Wait for and dispatch events once
+     *  @param timeout Timeout in milliseconds, -1 waits until an event arrives
+     *  @return Number of ready sources, 0 on timeout or -1 on error
+     */
+    int dispatch(int timeout = -1);
+
+    /** \brief Dispatch until stop() is called or an error occurs
+     *  @return 0 after stop(), -1 on error
+     */
+    int run();
+
+    /** \brief Make run() return after the current iteration */
+    void stop();
+
+private:
+    struct source {
+        int fd;
+        bool timer;
+        fd_handler on_fd;
+        timer_handler on_timer;
+    };
+
+    bool add_source(std::unique_ptr<source> s, std::uint32_t events);
+    void remove_source(int fd);
+    int flush(bool idle);
+
+    display& _display;
+    int _epoll_fd;
+    bool _want_output;
+    bool _stopped;
+    std::map<int, std::unique_ptr<source>> _sources;
+    std::vector<std::unique_ptr<source>> _removed;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_EVENT_LOOP_HPP_
+
@@ -0,0 +1,102 @@
+
+#ifndef _WLCPP_FRAME_CALLBACK_POOL_HPP_
+#define _WLCPP_FRAME_CALLBACK_POOL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "delegate.hpp"
+#include "generated/callback.hpp"
+#include "generated/surface.hpp"
+
+namespace wlcpp {
+
+/* Recycles the callback wrappers of surface::frame().
+ *
+ * A wl_callback is destroyed by the compositor after its done event, so the
+ * wl_proxy itself cannot be reused. The pool keeps the wrappers and handlers
+ * instead: request() moves the callback returned by surface::frame() into a
+ * free slot, the native object is destroyed right after done, and the slot is
+ * free again once the handler returned. A handler which requests the next
+ * frame therefore gets a second slot, so two slots per surface suffice. Once
+ * the pool has grown to that size, requesting a frame allocates nothing except
+ * the wl_proxy allocated by libwayland.
+ */
+class frame_callback_pool {
+public:
+    using handler_sig = void (std::uint32_t time);
+
+    /** \brief Create a pool with preallocated slots
+     *  @param capacity Number of slots to allocate up front
+     */
+    explicit frame_callback_pool(std::size_t capacity = 2) {
+        _free.reserve(capacity);
+        while(_slots.size() < capacity) {
+            grow();
+        }
+    }
+
+    frame_callback_pool(const frame_callback_pool&) = delete;
+    frame_callback_pool& operator=(const frame_callback_pool&) = delete;
+
+    /** \brief Request a frame callback for a surface
+     *  @param s Surface, which is not committed by this function
+     *  @param handler Called once with the time of the done event
+     */
+    template <typename T>
+    void request(surface& s, T&& handler) {
+        if(_free.empty()) {
+            grow();
+        }
+        slot* free_slot = _free.back();
+        _free.pop_back();
+
+        free_slot->cb = s.frame();
+        free_slot->handler = delegate<handler_sig>(std::forward<T>(handler));
+        free_slot->cb.set_done_handler([this, free_slot](std::uint32_t time) {
+            done(*free_slot, time);
+        });
+    }
+
+    /** \brief Number of requested callbacks whose done event is outstanding */
+    std::size_t pending() const {
+        return _slots.size() - _free.size();
+    }
+
+    /** \brief Number of slots, which only grows */
+    std::size_t capacity() const {
+        return _slots.size();
+    }
+
+private:
+    struct slot {
+        callback cb;
+        delegate<handler_sig> handler;
+    };
+
+    void grow() {
+        _slots.emplace_back();
+        if(_free.capacity() < _slots.size()) {
+            _free.reserve(2 * _slots.size());
+        }
+        _free.push_back(&_slots.back());
+    }
+
+    void done(slot& s, std::uint32_t time) {
+        // The wrapper is kept. The slot must not be reused before the handler
+        // returned, because the handler of its callback is still running.
+        s.cb.release_after_done();
+
+        s.handler(time);
+        _free.push_back(&s);
+    }
+
+    std::deque<slot> _slots;
+    std::vector<slot*> _free;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_FRAME_CALLBACK_POOL_HPP_
+
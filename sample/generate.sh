@@ -4,43 +4,41 @@ PROTOCOL=/usr/share/wayland/wayland.xml
 WLCPPGEN=../wlcppgen.py
 SRC_HPP=template/wlcpp.hpp.in
 SRC_CPP=template/wlcpp.cpp.in
+SRC_FWD=template/wlcpp_fwd.hpp.in
 OUTPUT_PATH=generated
 
-echo "generating file display.hpp"
-$WLCPPGEN --src $SRC_HPP --dst $OUTPUT_PATH/display.hpp \
-    --only wl_display \
-    --include-guard _DISPLAY_HPP_ \
-    --qualify-std-namespace \
-    --ignore-events \
-    $PROTOCOL
+# Files are only written if their content changed, which keeps incremental
+# builds incremental. display is generated into a temporary directory first,
+# because it is patched afterwards. display.patch only covers display.hpp and
+# display.cpp, so it does not depend on the manifest written next to them.
+DISPLAY_PATH=$(mktemp -d)
+trap 'rm -rf "$DISPLAY_PATH"' EXIT
 
-echo "generating file display.cpp"
-$WLCPPGEN --src $SRC_CPP --dst $OUTPUT_PATH/display.cpp \
+$WLCPPGEN --src-hpp $SRC_HPP --src-cpp $SRC_CPP --output-dir $DISPLAY_PATH \
     --only wl_display \
-    --header %c.hpp \
+    --forward-header %s_fwd.hpp \
     --ignore-events \
-    $PROTOCOL
+    --proxy-base proxy_base \
+    $PROTOCOL > /dev/null
 
-patch -p1 -d generated < template/display.patch
+patch -s -p1 -d $DISPLAY_PATH < template/display.patch
 
-INTERFACES=$($WLCPPGEN --list-interfaces --exclude wl_display $PROTOCOL)
-for i in $INTERFACES
+for i in display.hpp display.cpp
 do
-    CLASS=$($WLCPPGEN --list-classes --only $i $PROTOCOL)
-    DST_HPP=${CLASS}.hpp
-    DST_CPP=${CLASS}.cpp
-
-    echo "generating file $DST_HPP"
-    $WLCPPGEN --src $SRC_HPP --dst $OUTPUT_PATH/$DST_HPP \
-        --only $i \
-        --include-guard _%C_HPP_ \
-        --qualify-std-namespace \
-        $PROTOCOL
-
-    echo "generating file $DST_CPP"
-    $WLCPPGEN --src $SRC_CPP --dst $OUTPUT_PATH/$DST_CPP \
-        --only $i \
-        --header %c.hpp \
-        $PROTOCOL
+    if ! cmp -s $DISPLAY_PATH/$i $OUTPUT_PATH/$i
+    then
+        echo "generated file $i"
+        cp $DISPLAY_PATH/$i $OUTPUT_PATH/$i
+    fi
 done
 
+$WLCPPGEN --src-hpp $SRC_HPP --src-cpp $SRC_CPP --src-fwd $SRC_FWD --output-dir $OUTPUT_PATH \
+    --exclude wl_display \
+    --forward-header %s_fwd.hpp \
+    --handler-type delegate \
+    --dispatcher \
+    --interface-table \
+    --extra-includes ../string_ref.hpp \
+    --request-args \
+    --proxy-base proxy_base \
+    $PROTOCOL
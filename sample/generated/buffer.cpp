@@ -32,16 +32,16 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_buffer_request_destroy_types[] = { };
-
-static const wl_message wl_buffer_requests[] = {
-    { "destroy", "", wl_buffer_request_destroy_types },
+static const wl_interface* message_types[] = {
+    nullptr,
 };
 
-static const wl_interface* wl_buffer_event_release_types[] = { };
+static constexpr wl_message wl_buffer_requests[] = {
+    { "destroy", "", message_types + 0 },
+};
 
-static const wl_message wl_buffer_events[] = {
-    { "release", "", wl_buffer_event_release_types },
+static constexpr wl_message wl_buffer_events[] = {
+    { "release", "", message_types + 0 },
 };
 
 const wl_interface buffer::interface = {
@@ -54,14 +54,25 @@ const buffer::listener_t buffer::listener = {
     &release_handler,
 };
 
+int buffer::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        release_handler(data, wl_obj);
+        break;
+    }
+    return 0;
+}
+
 buffer::buffer(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<buffer>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 buffer::buffer(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<buffer>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 buffer::~buffer(){
@@ -70,7 +81,7 @@ buffer::~buffer(){
 
 void buffer::destroy() {
     if(valid() && managed()) {
-        marshal(0);
+        marshal_array(0, nullptr, interface.methods[0]);
     }
     proxy::destroy();
 }
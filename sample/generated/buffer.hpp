@@ -3,9 +3,14 @@
 #define _BUFFER_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -38,8 +43,6 @@
 namespace wlcpp {
 
 
-#define WLCPP_BUFFER_VERSION 1
-
 /** \brief content for a wl_surface
  *
  *  A buffer provides the content for a wl_surface. Buffers are created through
@@ -49,7 +52,7 @@ namespace wlcpp {
  *  interface.
  */
 class buffer final
-    : public proxy {
+    : public proxy_base<buffer> {
 public:
     /** \brief wl_interface for @ref buffer */
     static const wl_interface interface;
@@ -57,6 +60,9 @@ public:
     /** \brief @ref buffer version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref buffer, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 0;
+
     /** \brief Wrap existing wl_buffer object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_buffer object and is responsible for destryoing it
@@ -72,7 +78,7 @@ public:
     buffer(buffer&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~buffer();
+    ~buffer();
 
     /** \brief Default move assignment operator */
     buffer& operator=(buffer&& rhs) = default;
@@ -97,11 +103,12 @@ public:
      */
     template <typename T>
     void set_release_handler(T&& handler) {
-        _release_handler = std::function<release_handler_sig>(std::forward<T>(handler));
+        _release_handler = delegate<release_handler_sig>(std::forward<T>(handler));
     }
 
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<buffer>;
 
 private:
     struct listener_t {
@@ -112,7 +119,9 @@ private:
 
     static const listener_t listener;
 
-    std::function<release_handler_sig> _release_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<release_handler_sig> _release_handler;
 };
 
 } // namespace wlcpp
@@ -32,10 +32,12 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_callback_event_done_types[] = { nullptr };
+static const wl_interface* message_types[] = {
+    nullptr,
+};
 
-static const wl_message wl_callback_events[] = {
-    { "done", "u", wl_callback_event_done_types },
+static constexpr wl_message wl_callback_events[] = {
+    { "done", "u", message_types + 0 },
 };
 
 const wl_interface callback::interface = {
@@ -48,14 +50,25 @@ const callback::listener_t callback::listener = {
     &done_handler,
 };
 
+int callback::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        done_handler(data, wl_obj, args[0].u);
+        break;
+    }
+    return 0;
+}
+
 callback::callback(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<callback>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 callback::callback(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<callback>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 void callback::done_handler(void* data, wl_proxy* wl_obj, uint32_t serial_) {
@@ -3,9 +3,14 @@
 #define _CALLBACK_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -38,15 +43,13 @@
 namespace wlcpp {
 
 
-#define WLCPP_CALLBACK_VERSION 1
-
 /** \brief callback object
  *
  *  Clients can handle the 'done' event to get notified when the related request
  *  is done.
  */
 class callback final
-    : public proxy {
+    : public proxy_base<callback> {
 public:
     /** \brief wl_interface for @ref callback */
     static const wl_interface interface;
@@ -54,6 +57,9 @@ public:
     /** \brief @ref callback version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref callback, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_callback object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_callback object and is responsible for destryoing it
@@ -69,7 +75,7 @@ public:
     callback(callback&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~callback() = default;
+    ~callback() = default;
 
     /** \brief Default move assignment operator */
     callback& operator=(callback&& rhs) = default;
@@ -87,7 +93,7 @@ public:
      */
     template <typename T>
     void set_done_handler(T&& handler) {
-        _done_handler = std::function<done_handler_sig>(std::forward<T>(handler));
+        _done_handler = delegate<done_handler_sig>(std::forward<T>(handler));
     }
 
 private:
@@ -99,7 +105,9 @@ private:
 
     static const listener_t listener;
 
-    std::function<done_handler_sig> _done_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<done_handler_sig> _done_handler;
 };
 
 } // namespace wlcpp
@@ -34,12 +34,15 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_compositor_request_create_surface_types[] = { &surface::interface };
-static const wl_interface* wl_compositor_request_create_region_types[] = { &region::interface };
+static const wl_interface* message_types[] = {
+    nullptr,
+    &surface::interface,
+    &region::interface,
+};
 
-static const wl_message wl_compositor_requests[] = {
-    { "create_surface", "n", wl_compositor_request_create_surface_types },
-    { "create_region", "n", wl_compositor_request_create_region_types },
+static constexpr wl_message wl_compositor_requests[] = {
+    { "create_surface", "n", message_types + 1 },
+    { "create_region", "n", message_types + 2 },
 };
 
 const wl_interface compositor::interface = {
@@ -49,22 +52,22 @@ const wl_interface compositor::interface = {
 };
 
 compositor::compositor(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
+    : proxy_base<compositor>(obj, managed) {
 }
 
 compositor::compositor(proxy& factory)
-    : proxy(factory, interface) {
+    : proxy_base<compositor>(factory, interface) {
 }
 
 surface compositor::create_surface() {
-    surface id_(*this);
-    marshal(0, id_.wl_obj());
-    return id_;
+    wl_argument args[1];
+    args[0].o = nullptr;
+    return wrap<surface>(marshal_array_constructor(0, args, surface::interface, interface.methods[0]));
 }
 
 region compositor::create_region() {
-    region id_(*this);
-    marshal(1, id_.wl_obj());
-    return id_;
+    wl_argument args[1];
+    args[0].o = nullptr;
+    return wrap<region>(marshal_array_constructor(1, args, region::interface, interface.methods[1]));
 }
 
@@ -3,9 +3,14 @@
 #define _COMPOSITOR_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,10 +42,6 @@
 
 namespace wlcpp {
 
-class region;
-class surface;
-
-#define WLCPP_COMPOSITOR_VERSION 3
 
 /** \brief the compositor singleton
  *
@@ -48,7 +49,7 @@ class surface;
  *  of combining the contents of multiple surfaces into one displayable output.
  */
 class compositor final
-    : public proxy {
+    : public proxy_base<compositor> {
 public:
     /** \brief wl_interface for @ref compositor */
     static const wl_interface interface;
@@ -56,6 +57,9 @@ public:
     /** \brief @ref compositor version at wrapper generation time */
     static constexpr std::uint32_t version = 3;
 
+    /** \brief Opcode of the destructor request of @ref compositor, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_compositor object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_compositor object and is responsible for destryoing it
@@ -71,7 +75,7 @@ public:
     compositor(compositor&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~compositor() = default;
+    ~compositor() = default;
 
     /** \brief Default move assignment operator */
     compositor& operator=(compositor&& rhs) = default;
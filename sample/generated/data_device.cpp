@@ -35,28 +35,36 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_data_device_request_start_drag_types[] = { &data_source::interface, &surface::interface, &surface::interface, nullptr };
-static const wl_interface* wl_data_device_request_set_selection_types[] = { &data_source::interface, nullptr };
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    &data_source::interface,
+    &surface::interface,
+    &surface::interface,
+    nullptr,
+    &data_source::interface,
+    nullptr,
+    &data_offer::interface,
+    nullptr,
+    &surface::interface,
+    nullptr,
+    nullptr,
+    &data_offer::interface,
+};
 
-static const wl_message wl_data_device_requests[] = {
-    { "start_drag", "?oo?ou", wl_data_device_request_start_drag_types },
-    { "set_selection", "?ou", wl_data_device_request_set_selection_types },
+static constexpr wl_message wl_data_device_requests[] = {
+    { "start_drag", "?oo?ou", message_types + 3 },
+    { "set_selection", "?ou", message_types + 7 },
 };
 
-static const wl_interface* wl_data_device_event_data_offer_types[] = { &data_offer::interface };
-static const wl_interface* wl_data_device_event_enter_types[] = { nullptr, &surface::interface, nullptr, nullptr, &data_offer::interface };
-static const wl_interface* wl_data_device_event_leave_types[] = { };
-static const wl_interface* wl_data_device_event_motion_types[] = { nullptr, nullptr, nullptr };
-static const wl_interface* wl_data_device_event_drop_types[] = { };
-static const wl_interface* wl_data_device_event_selection_types[] = { &data_offer::interface };
-
-static const wl_message wl_data_device_events[] = {
-    { "data_offer", "n", wl_data_device_event_data_offer_types },
-    { "enter", "uoff?o", wl_data_device_event_enter_types },
-    { "leave", "", wl_data_device_event_leave_types },
-    { "motion", "uff", wl_data_device_event_motion_types },
-    { "drop", "", wl_data_device_event_drop_types },
-    { "selection", "?o", wl_data_device_event_selection_types },
+static constexpr wl_message wl_data_device_events[] = {
+    { "data_offer", "n", message_types + 9 },
+    { "enter", "uoff?o", message_types + 10 },
+    { "leave", "", message_types + 0 },
+    { "motion", "uff", message_types + 0 },
+    { "drop", "", message_types + 0 },
+    { "selection", "?o", message_types + 9 },
 };
 
 const wl_interface data_device::interface = {
@@ -74,35 +82,69 @@ const data_device::listener_t data_device::listener = {
     &selection_handler,
 };
 
+int data_device::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        data_offer_handler(data, wl_obj, reinterpret_cast<wl_proxy*>(args[0].o));
+        break;
+    case 1:
+        enter_handler(data, wl_obj, args[0].u, reinterpret_cast<wl_proxy*>(args[1].o), args[2].f, args[3].f, reinterpret_cast<wl_proxy*>(args[4].o));
+        break;
+    case 2:
+        leave_handler(data, wl_obj);
+        break;
+    case 3:
+        motion_handler(data, wl_obj, args[0].u, args[1].f, args[2].f);
+        break;
+    case 4:
+        drop_handler(data, wl_obj);
+        break;
+    case 5:
+        selection_handler(data, wl_obj, reinterpret_cast<wl_proxy*>(args[0].o));
+        break;
+    }
+    return 0;
+}
+
 data_device::data_device(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<data_device>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 data_device::data_device(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<data_device>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 void data_device::start_drag(data_source* source_, surface& origin_, surface* icon_, uint32_t serial_) {
-    marshal(0, source_ ? source_->wl_obj() : nullptr, origin_.wl_obj(), icon_ ? icon_->wl_obj() : nullptr, serial_);
+    wl_argument args[4];
+    args[0].o = source_ ? reinterpret_cast<wl_object*>(source_->wl_obj()) : nullptr;
+    args[1].o = reinterpret_cast<wl_object*>(origin_.wl_obj());
+    args[2].o = icon_ ? reinterpret_cast<wl_object*>(icon_->wl_obj()) : nullptr;
+    args[3].u = serial_;
+    marshal_array(0, args, interface.methods[0]);
 }
 
 void data_device::set_selection(data_source* source_, uint32_t serial_) {
-    marshal(1, source_ ? source_->wl_obj() : nullptr, serial_);
+    wl_argument args[2];
+    args[0].o = source_ ? reinterpret_cast<wl_object*>(source_->wl_obj()) : nullptr;
+    args[1].u = serial_;
+    marshal_array(1, args, interface.methods[1]);
 }
 
 void data_device::data_offer_handler(void* data, wl_proxy* wl_obj, wl_proxy* id_) {
     auto& handler = proxy::user_data_to_wrapper_cast<data_device>(data)->_data_offer_handler;
     if(handler) {
-        handler(data_offer(id_));
+        handler(proxy::wrap<data_offer>(data, id_));
     }
 }
 
 void data_device::enter_handler(void* data, wl_proxy* wl_obj, uint32_t serial_, wl_proxy* surface_, wl_fixed_t x_, wl_fixed_t y_, wl_proxy* id_) {
     auto& handler = proxy::user_data_to_wrapper_cast<data_device>(data)->_enter_handler;
     if(handler) {
-        handler(serial_, *proxy::wrapper_cast<surface>(surface_), x_, y_, proxy::wrapper_cast<data_offer>(id_));
+        handler(serial_, *proxy::wrapper_cast<surface>(data, surface_), x_, y_, proxy::wrapper_cast<data_offer>(data, id_));
     }
 }
 
@@ -130,7 +172,7 @@ void data_device::drop_handler(void* data, wl_proxy* wl_obj) {
 void data_device::selection_handler(void* data, wl_proxy* wl_obj, wl_proxy* id_) {
     auto& handler = proxy::user_data_to_wrapper_cast<data_device>(data)->_selection_handler;
     if(handler) {
-        handler(proxy::wrapper_cast<data_offer>(id_));
+        handler(proxy::wrapper_cast<data_offer>(data, id_));
     }
 }
 
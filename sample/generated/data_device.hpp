@@ -3,9 +3,14 @@
 #define _DATA_DEVICE_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,11 +42,6 @@
 
 namespace wlcpp {
 
-class data_offer;
-class data_source;
-class surface;
-
-#define WLCPP_DATA_DEVICE_VERSION 1
 
 /** \brief data transfer device
  *
@@ -52,7 +52,7 @@ class surface;
  *  such as copy-and-paste and drag-and-drop.
  */
 class data_device final
-    : public proxy {
+    : public proxy_base<data_device> {
 public:
     /** \brief wl_interface for @ref data_device */
     static const wl_interface interface;
@@ -60,6 +60,9 @@ public:
     /** \brief @ref data_device version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref data_device, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_data_device object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_data_device object and is responsible for destryoing it
@@ -75,7 +78,7 @@ public:
     data_device(data_device&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~data_device() = default;
+    ~data_device() = default;
 
     /** \brief Default move assignment operator */
     data_device& operator=(data_device&& rhs) = default;
@@ -111,6 +114,28 @@ public:
      */
     void start_drag(data_source* source_, surface& origin_, surface* icon_, std::uint32_t serial_);
 
+    /** \brief Arguments of @ref start_drag, objects are passed as native objects */
+    struct start_drag_args {
+        static constexpr std::uint32_t opcode = 0;
+        static constexpr std::uint32_t arg_count = 4;
+
+        wl_proxy* source_;
+        wl_proxy* origin_;
+        wl_proxy* icon_;
+        std::uint32_t serial_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(source_);
+            args[1].o = reinterpret_cast<wl_object*>(origin_);
+            args[2].o = reinterpret_cast<wl_object*>(icon_);
+            args[3].u = serial_;
+        }
+    };
+
     /** \brief copy data to the selection
      *
      *  This request asks the compositor to set the selection to the data from the
@@ -123,6 +148,24 @@ public:
      */
     void set_selection(data_source* source_, std::uint32_t serial_);
 
+    /** \brief Arguments of @ref set_selection, objects are passed as native objects */
+    struct set_selection_args {
+        static constexpr std::uint32_t opcode = 1;
+        static constexpr std::uint32_t arg_count = 2;
+
+        wl_proxy* source_;
+        std::uint32_t serial_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(source_);
+            args[1].u = serial_;
+        }
+    };
+
     /** \brief introduce a new wl_data_offer
      *
      *  The data_offer event introduces a new wl_data_offer object, which will
@@ -141,7 +184,7 @@ public:
      */
     template <typename T>
     void set_data_offer_handler(T&& handler) {
-        _data_offer_handler = std::function<data_offer_handler_sig>(std::forward<T>(handler));
+        _data_offer_handler = delegate<data_offer_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief initiate drag-and-drop session
@@ -163,7 +206,7 @@ public:
      */
     template <typename T>
     void set_enter_handler(T&& handler) {
-        _enter_handler = std::function<enter_handler_sig>(std::forward<T>(handler));
+        _enter_handler = delegate<enter_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief end drag-and-drop session
@@ -179,7 +222,7 @@ public:
      */
     template <typename T>
     void set_leave_handler(T&& handler) {
-        _leave_handler = std::function<leave_handler_sig>(std::forward<T>(handler));
+        _leave_handler = delegate<leave_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief drag-and-drop session motion
@@ -199,7 +242,7 @@ public:
      */
     template <typename T>
     void set_motion_handler(T&& handler) {
-        _motion_handler = std::function<motion_handler_sig>(std::forward<T>(handler));
+        _motion_handler = delegate<motion_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief end drag-and-drag session successfully
@@ -214,7 +257,7 @@ public:
      */
     template <typename T>
     void set_drop_handler(T&& handler) {
-        _drop_handler = std::function<drop_handler_sig>(std::forward<T>(handler));
+        _drop_handler = delegate<drop_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief advertise new selection
@@ -236,7 +279,7 @@ public:
      */
     template <typename T>
     void set_selection_handler(T&& handler) {
-        _selection_handler = std::function<selection_handler_sig>(std::forward<T>(handler));
+        _selection_handler = delegate<selection_handler_sig>(std::forward<T>(handler));
     }
 
 private:
@@ -258,12 +301,14 @@ private:
 
     static const listener_t listener;
 
-    std::function<data_offer_handler_sig> _data_offer_handler;
-    std::function<enter_handler_sig> _enter_handler;
-    std::function<leave_handler_sig> _leave_handler;
-    std::function<motion_handler_sig> _motion_handler;
-    std::function<drop_handler_sig> _drop_handler;
-    std::function<selection_handler_sig> _selection_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<data_offer_handler_sig> _data_offer_handler;
+    delegate<enter_handler_sig> _enter_handler;
+    delegate<leave_handler_sig> _leave_handler;
+    delegate<motion_handler_sig> _motion_handler;
+    delegate<drop_handler_sig> _drop_handler;
+    delegate<selection_handler_sig> _selection_handler;
 };
 
 } // namespace wlcpp
@@ -35,12 +35,16 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_data_device_manager_request_create_data_source_types[] = { &data_source::interface };
-static const wl_interface* wl_data_device_manager_request_get_data_device_types[] = { &data_device::interface, &seat::interface };
+static const wl_interface* message_types[] = {
+    nullptr,
+    &data_source::interface,
+    &data_device::interface,
+    &seat::interface,
+};
 
-static const wl_message wl_data_device_manager_requests[] = {
-    { "create_data_source", "n", wl_data_device_manager_request_create_data_source_types },
-    { "get_data_device", "no", wl_data_device_manager_request_get_data_device_types },
+static constexpr wl_message wl_data_device_manager_requests[] = {
+    { "create_data_source", "n", message_types + 1 },
+    { "get_data_device", "no", message_types + 2 },
 };
 
 const wl_interface data_device_manager::interface = {
@@ -50,22 +54,23 @@ const wl_interface data_device_manager::interface = {
 };
 
 data_device_manager::data_device_manager(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
+    : proxy_base<data_device_manager>(obj, managed) {
 }
 
 data_device_manager::data_device_manager(proxy& factory)
-    : proxy(factory, interface) {
+    : proxy_base<data_device_manager>(factory, interface) {
 }
 
 data_source data_device_manager::create_data_source() {
-    data_source id_(*this);
-    marshal(0, id_.wl_obj());
-    return id_;
+    wl_argument args[1];
+    args[0].o = nullptr;
+    return wrap<data_source>(marshal_array_constructor(0, args, data_source::interface, interface.methods[0]));
 }
 
 data_device data_device_manager::get_data_device(seat& seat_) {
-    data_device id_(*this);
-    marshal(1, id_.wl_obj(), seat_.wl_obj());
-    return id_;
+    wl_argument args[2];
+    args[0].o = nullptr;
+    args[1].o = reinterpret_cast<wl_object*>(seat_.wl_obj());
+    return wrap<data_device>(marshal_array_constructor(1, args, data_device::interface, interface.methods[1]));
 }
 
@@ -3,9 +3,14 @@
 #define _DATA_DEVICE_MANAGER_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,11 +42,6 @@
 
 namespace wlcpp {
 
-class data_device;
-class data_source;
-class seat;
-
-#define WLCPP_DATA_DEVICE_MANAGER_VERSION 1
 
 /** \brief data transfer interface
  *
@@ -51,7 +51,7 @@ class seat;
  *  lets a client get a wl_data_device corresponding to a wl_seat.
  */
 class data_device_manager final
-    : public proxy {
+    : public proxy_base<data_device_manager> {
 public:
     /** \brief wl_interface for @ref data_device_manager */
     static const wl_interface interface;
@@ -59,6 +59,9 @@ public:
     /** \brief @ref data_device_manager version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref data_device_manager, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_data_device_manager object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_data_device_manager object and is responsible for destryoing it
@@ -74,7 +77,7 @@ public:
     data_device_manager(data_device_manager&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~data_device_manager() = default;
+    ~data_device_manager() = default;
 
     /** \brief Default move assignment operator */
     data_device_manager& operator=(data_device_manager&& rhs) = default;
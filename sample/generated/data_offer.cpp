@@ -32,20 +32,19 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_data_offer_request_accept_types[] = { nullptr, nullptr };
-static const wl_interface* wl_data_offer_request_receive_types[] = { nullptr, nullptr };
-static const wl_interface* wl_data_offer_request_destroy_types[] = { };
-
-static const wl_message wl_data_offer_requests[] = {
-    { "accept", "u?s", wl_data_offer_request_accept_types },
-    { "receive", "sh", wl_data_offer_request_receive_types },
-    { "destroy", "", wl_data_offer_request_destroy_types },
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
 };
 
-static const wl_interface* wl_data_offer_event_offer_types[] = { nullptr };
+static constexpr wl_message wl_data_offer_requests[] = {
+    { "accept", "u?s", message_types + 0 },
+    { "receive", "sh", message_types + 0 },
+    { "destroy", "", message_types + 0 },
+};
 
-static const wl_message wl_data_offer_events[] = {
-    { "offer", "s", wl_data_offer_event_offer_types },
+static constexpr wl_message wl_data_offer_events[] = {
+    { "offer", "s", message_types + 0 },
 };
 
 const wl_interface data_offer::interface = {
@@ -58,14 +57,25 @@ const data_offer::listener_t data_offer::listener = {
     &offer_handler,
 };
 
+int data_offer::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        offer_handler(data, wl_obj, args[0].s);
+        break;
+    }
+    return 0;
+}
+
 data_offer::data_offer(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<data_offer>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 data_offer::data_offer(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<data_offer>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 data_offer::~data_offer(){
@@ -73,16 +83,22 @@ data_offer::~data_offer(){
 }
 
 void data_offer::accept(uint32_t serial_, const string* mime_type_) {
-    marshal(0, serial_, mime_type_ ? mime_type_->c_str() : nullptr);
+    wl_argument args[2];
+    args[0].u = serial_;
+    args[1].s = mime_type_ ? mime_type_->c_str() : nullptr;
+    marshal_array(0, args, interface.methods[0]);
 }
 
 void data_offer::receive(const string& mime_type_, int32_t fd_) {
-    marshal(1, mime_type_.c_str(), fd_);
+    wl_argument args[2];
+    args[0].s = mime_type_.c_str();
+    args[1].h = fd_;
+    marshal_array(1, args, interface.methods[1]);
 }
 
 void data_offer::destroy() {
     if(valid() && managed()) {
-        marshal(2);
+        marshal_array(2, nullptr, interface.methods[2]);
     }
     proxy::destroy();
 }
@@ -3,9 +3,14 @@
 #define _DATA_OFFER_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -38,8 +43,6 @@
 namespace wlcpp {
 
 
-#define WLCPP_DATA_OFFER_VERSION 1
-
 /** \brief offer to transfer data
  *
  *  A wl_data_offer represents a piece of data offered for transfer by another
@@ -49,7 +52,7 @@ namespace wlcpp {
  *  data directly from the source client.
  */
 class data_offer final
-    : public proxy {
+    : public proxy_base<data_offer> {
 public:
     /** \brief wl_interface for @ref data_offer */
     static const wl_interface interface;
@@ -57,6 +60,9 @@ public:
     /** \brief @ref data_offer version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref data_offer, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 2;
+
     /** \brief Wrap existing wl_data_offer object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_data_offer object and is responsible for destryoing it
@@ -72,7 +78,7 @@ public:
     data_offer(data_offer&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~data_offer();
+    ~data_offer();
 
     /** \brief Default move assignment operator */
     data_offer& operator=(data_offer&& rhs) = default;
@@ -112,18 +118,19 @@ public:
      *
      *  @param mime_type_
      */
-    using offer_handler_sig = void (const std::string& mime_type_);
+    using offer_handler_sig = void (string_ref mime_type_);
 
     /** \brief Set a handler for the offer event
      *  @param handler Callable of signature @ref offer_handler_sig
      */
     template <typename T>
     void set_offer_handler(T&& handler) {
-        _offer_handler = std::function<offer_handler_sig>(std::forward<T>(handler));
+        _offer_handler = delegate<offer_handler_sig>(std::forward<T>(handler));
     }
 
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<data_offer>;
 
 private:
     struct listener_t {
@@ -134,7 +141,9 @@ private:
 
     static const listener_t listener;
 
-    std::function<offer_handler_sig> _offer_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<offer_handler_sig> _offer_handler;
 };
 
 } // namespace wlcpp
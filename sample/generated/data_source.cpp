@@ -32,22 +32,20 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_data_source_request_offer_types[] = { nullptr };
-static const wl_interface* wl_data_source_request_destroy_types[] = { };
-
-static const wl_message wl_data_source_requests[] = {
-    { "offer", "s", wl_data_source_request_offer_types },
-    { "destroy", "", wl_data_source_request_destroy_types },
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
 };
 
-static const wl_interface* wl_data_source_event_target_types[] = { nullptr };
-static const wl_interface* wl_data_source_event_send_types[] = { nullptr, nullptr };
-static const wl_interface* wl_data_source_event_cancelled_types[] = { };
+static constexpr wl_message wl_data_source_requests[] = {
+    { "offer", "s", message_types + 0 },
+    { "destroy", "", message_types + 0 },
+};
 
-static const wl_message wl_data_source_events[] = {
-    { "target", "?s", wl_data_source_event_target_types },
-    { "send", "sh", wl_data_source_event_send_types },
-    { "cancelled", "", wl_data_source_event_cancelled_types },
+static constexpr wl_message wl_data_source_events[] = {
+    { "target", "?s", message_types + 0 },
+    { "send", "sh", message_types + 0 },
+    { "cancelled", "", message_types + 0 },
 };
 
 const wl_interface data_source::interface = {
@@ -62,14 +60,31 @@ const data_source::listener_t data_source::listener = {
     &cancelled_handler,
 };
 
+int data_source::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        target_handler(data, wl_obj, args[0].s);
+        break;
+    case 1:
+        send_handler(data, wl_obj, args[0].s, args[1].h);
+        break;
+    case 2:
+        cancelled_handler(data, wl_obj);
+        break;
+    }
+    return 0;
+}
+
 data_source::data_source(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<data_source>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 data_source::data_source(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<data_source>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 data_source::~data_source(){
@@ -77,12 +92,14 @@ data_source::~data_source(){
 }
 
 void data_source::offer(const string& mime_type_) {
-    marshal(0, mime_type_.c_str());
+    wl_argument args[1];
+    args[0].s = mime_type_.c_str();
+    marshal_array(0, args, interface.methods[0]);
 }
 
 void data_source::destroy() {
     if(valid() && managed()) {
-        marshal(1);
+        marshal_array(1, nullptr, interface.methods[1]);
     }
     proxy::destroy();
 }
@@ -90,7 +107,7 @@ void data_source::destroy() {
 void data_source::target_handler(void* data, wl_proxy* wl_obj, const char* mime_type_) {
     auto& handler = proxy::user_data_to_wrapper_cast<data_source>(data)->_target_handler;
     if(handler) {
-        string mime_type_str = mime_type_ ? mime_type_ : string();
+        string_ref mime_type_str = mime_type_ ? mime_type_ : string_ref();
         handler(mime_type_ ? &mime_type_str : nullptr);
     }
 }
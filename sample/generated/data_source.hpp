@@ -3,9 +3,14 @@
 #define _DATA_SOURCE_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -38,8 +43,6 @@
 namespace wlcpp {
 
 
-#define WLCPP_DATA_SOURCE_VERSION 1
-
 /** \brief offer to transfer data
  *
  *  The wl_data_source object is the source side of a wl_data_offer. It is
@@ -48,7 +51,7 @@ namespace wlcpp {
  *  data.
  */
 class data_source final
-    : public proxy {
+    : public proxy_base<data_source> {
 public:
     /** \brief wl_interface for @ref data_source */
     static const wl_interface interface;
@@ -56,6 +59,9 @@ public:
     /** \brief @ref data_source version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref data_source, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 1;
+
     /** \brief Wrap existing wl_data_source object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_data_source object and is responsible for destryoing it
@@ -71,7 +77,7 @@ public:
     data_source(data_source&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~data_source();
+    ~data_source();
 
     /** \brief Default move assignment operator */
     data_source& operator=(data_source&& rhs) = default;
@@ -94,14 +100,14 @@ public:
      *
      *  @param mime_type_
      */
-    using target_handler_sig = void (const std::string* mime_type_);
+    using target_handler_sig = void (const string_ref* mime_type_);
 
     /** \brief Set a handler for the target event
      *  @param handler Callable of signature @ref target_handler_sig
      */
     template <typename T>
     void set_target_handler(T&& handler) {
-        _target_handler = std::function<target_handler_sig>(std::forward<T>(handler));
+        _target_handler = delegate<target_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief send the data
@@ -112,14 +118,14 @@ public:
      *  @param mime_type_
      *  @param fd_
      */
-    using send_handler_sig = void (const std::string& mime_type_, std::int32_t fd_);
+    using send_handler_sig = void (string_ref mime_type_, std::int32_t fd_);
 
     /** \brief Set a handler for the send event
      *  @param handler Callable of signature @ref send_handler_sig
      */
     template <typename T>
     void set_send_handler(T&& handler) {
-        _send_handler = std::function<send_handler_sig>(std::forward<T>(handler));
+        _send_handler = delegate<send_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief selection was cancelled
@@ -134,11 +140,12 @@ public:
      */
     template <typename T>
     void set_cancelled_handler(T&& handler) {
-        _cancelled_handler = std::function<cancelled_handler_sig>(std::forward<T>(handler));
+        _cancelled_handler = delegate<cancelled_handler_sig>(std::forward<T>(handler));
     }
 
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<data_source>;
 
 private:
     struct listener_t {
@@ -153,9 +160,11 @@ private:
 
     static const listener_t listener;
 
-    std::function<target_handler_sig> _target_handler;
-    std::function<send_handler_sig> _send_handler;
-    std::function<cancelled_handler_sig> _cancelled_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<target_handler_sig> _target_handler;
+    delegate<send_handler_sig> _send_handler;
+    delegate<cancelled_handler_sig> _cancelled_handler;
 };
 
 } // namespace wlcpp
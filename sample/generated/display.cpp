@@ -34,20 +34,22 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_display_request_sync_types[] = { &callback::interface };
-static const wl_interface* wl_display_request_get_registry_types[] = { &registry::interface };
-
-static const wl_message wl_display_requests[] = {
-    { "sync", "n", wl_display_request_sync_types },
-    { "get_registry", "n", wl_display_request_get_registry_types },
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    &callback::interface,
+    &registry::interface,
 };
 
-static const wl_interface* wl_display_event_error_types[] = { nullptr, nullptr, nullptr };
-static const wl_interface* wl_display_event_delete_id_types[] = { nullptr };
+static constexpr wl_message wl_display_requests[] = {
+    { "sync", "n", message_types + 3 },
+    { "get_registry", "n", message_types + 4 },
+};
 
-static const wl_message wl_display_events[] = {
-    { "error", "ous", wl_display_event_error_types },
-    { "delete_id", "u", wl_display_event_delete_id_types },
+static constexpr wl_message wl_display_events[] = {
+    { "error", "ous", message_types + 0 },
+    { "delete_id", "u", message_types + 0 },
 };
 
 const wl_interface display::interface = {
@@ -57,15 +59,18 @@ const wl_interface display::interface = {
 };
 
 display::display(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
+    : proxy_base<display>(obj, managed) {
+    create_object_table();
 }
 
 display::display(const string& name)
-    : proxy(reinterpret_cast<wl_proxy*>(name.empty() ? wl_display_connect(nullptr) : wl_display_connect(name.c_str()))) {
+    : proxy_base<display>(reinterpret_cast<wl_proxy*>(name.empty() ? wl_display_connect(nullptr) : wl_display_connect(name.c_str()))) {
+    create_object_table();
 }
 
 display::display(int fd)
-    : proxy(reinterpret_cast<wl_proxy*>(wl_display_connect_to_fd(fd))) {
+    : proxy_base<display>(reinterpret_cast<wl_proxy*>(wl_display_connect_to_fd(fd))) {
+    create_object_table();
 }
 
 display::~display() {
@@ -128,22 +133,34 @@ int display::read_events() {
     return wl_display_read_events(wl_obj());
 }
 
+proxy* display::find(uint32_t id) const {
+    return _objects ? _objects->find(id) : nullptr;
+}
+
 callback display::sync() {
-    callback callback_(*this);
-    marshal(0, callback_.wl_obj());
-    return callback_;
+    wl_argument args[1];
+    args[0].o = nullptr;
+    return wrap<callback>(marshal_array_constructor(0, args, callback::interface, interface.methods[0]));
 }
 
 registry display::get_registry() {
-    registry callback_(*this);
-    marshal(1, callback_.wl_obj());
-    return callback_;
+    wl_argument args[1];
+    args[0].o = nullptr;
+    return wrap<registry>(marshal_array_constructor(1, args, registry::interface, interface.methods[1]));
 }
 
 void display::destroy() {
     if(valid() && managed()) {
-        wl_display_disconnect(wl_obj());
+        wl_display* obj = wl_obj();
         invalidate();
+        wl_display_disconnect(obj);
+    }
+}
+
+void display::create_object_table() {
+    if(valid() && managed()) {
+        _objects.reset(new object_table());
+        set_object_table(_objects.get());
     }
 }
 
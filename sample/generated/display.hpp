@@ -3,9 +3,14 @@
 #define _DISPLAY_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,21 +42,6 @@
 
 namespace wlcpp {
 
-class callback;
-class registry;
-
-#define WLCPP_DISPLAY_VERSION 1
-
-/** \brief global error values
- *
- *  These errors are global and can be emitted in response to any server
- *  request.
- */
-enum display_error {
-    DISPLAY_ERROR_INVALID_OBJECT = 0, /**< server couldn't find object */
-    DISPLAY_ERROR_INVALID_METHOD = 1, /**< method doesn't exist on the specified interface */
-    DISPLAY_ERROR_NO_MEMORY = 2, /**< server is out of memory */
-};
 
 /** \brief core global object
  *
@@ -59,7 +49,7 @@ enum display_error {
  *  internal Wayland protocol features.
  */
 class display final
-    : public proxy {
+    : public proxy_base<display> {
 public:
     /** \brief wl_interface for @ref display */
     static const wl_interface interface;
@@ -67,6 +57,9 @@ public:
     /** \brief @ref display version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref display, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_display object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_display object and is responsible for destryoing it
@@ -81,7 +74,7 @@ public:
     display(display&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~display();
+    ~display();
 
     /** \brief Default move assignment operator */
     display& operator=(display&& rhs) = default;
@@ -100,6 +93,7 @@ public:
     int prepare_read();
     void cancel_read();
     int read_events();
+    proxy* find(std::uint32_t id) const;
 
     /** \brief asynchronous roundtrip
      *
@@ -126,7 +120,13 @@ public:
     registry get_registry();
 
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<display>;
+
+private:
+    void create_object_table();
+
+    std::unique_ptr<object_table> _objects;
 };
 
 } // namespace wlcpp
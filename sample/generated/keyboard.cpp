@@ -33,24 +33,27 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_keyboard_request_release_types[] = { };
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    &surface::interface,
+    nullptr,
+};
 
-static const wl_message wl_keyboard_requests[] = {
-    { "release", "3", wl_keyboard_request_release_types },
+static constexpr wl_message wl_keyboard_requests[] = {
+    { "release", "3", message_types + 0 },
 };
 
-static const wl_interface* wl_keyboard_event_keymap_types[] = { nullptr, nullptr, nullptr };
-static const wl_interface* wl_keyboard_event_enter_types[] = { nullptr, &surface::interface, nullptr };
-static const wl_interface* wl_keyboard_event_leave_types[] = { nullptr, &surface::interface };
-static const wl_interface* wl_keyboard_event_key_types[] = { nullptr, nullptr, nullptr, nullptr };
-static const wl_interface* wl_keyboard_event_modifiers_types[] = { nullptr, nullptr, nullptr, nullptr, nullptr };
-
-static const wl_message wl_keyboard_events[] = {
-    { "keymap", "uhu", wl_keyboard_event_keymap_types },
-    { "enter", "uoa", wl_keyboard_event_enter_types },
-    { "leave", "uo", wl_keyboard_event_leave_types },
-    { "key", "uuuu", wl_keyboard_event_key_types },
-    { "modifiers", "uuuuu", wl_keyboard_event_modifiers_types },
+static constexpr wl_message wl_keyboard_events[] = {
+    { "keymap", "uhu", message_types + 0 },
+    { "enter", "uoa", message_types + 5 },
+    { "leave", "uo", message_types + 5 },
+    { "key", "uuuu", message_types + 0 },
+    { "modifiers", "uuuuu", message_types + 0 },
 };
 
 const wl_interface keyboard::interface = {
@@ -67,14 +70,37 @@ const keyboard::listener_t keyboard::listener = {
     &modifiers_handler,
 };
 
+int keyboard::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        keymap_handler(data, wl_obj, args[0].u, args[1].h, args[2].u);
+        break;
+    case 1:
+        enter_handler(data, wl_obj, args[0].u, reinterpret_cast<wl_proxy*>(args[1].o), args[2].a);
+        break;
+    case 2:
+        leave_handler(data, wl_obj, args[0].u, reinterpret_cast<wl_proxy*>(args[1].o));
+        break;
+    case 3:
+        key_handler(data, wl_obj, args[0].u, args[1].u, args[2].u, args[3].u);
+        break;
+    case 4:
+        modifiers_handler(data, wl_obj, args[0].u, args[1].u, args[2].u, args[3].u, args[4].u);
+        break;
+    }
+    return 0;
+}
+
 keyboard::keyboard(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<keyboard>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 keyboard::keyboard(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<keyboard>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 keyboard::~keyboard(){
@@ -83,7 +109,7 @@ keyboard::~keyboard(){
 
 void keyboard::destroy() {
     if(valid() && managed()) {
-        marshal(0);
+        marshal_array(0, nullptr, interface.methods[0]);
     }
     proxy::destroy();
 }
@@ -98,14 +124,14 @@ void keyboard::keymap_handler(void* data, wl_proxy* wl_obj, uint32_t format_, in
 void keyboard::enter_handler(void* data, wl_proxy* wl_obj, uint32_t serial_, wl_proxy* surface_, const wl_array* keys_) {
     auto& handler = proxy::user_data_to_wrapper_cast<keyboard>(data)->_enter_handler;
     if(handler) {
-        handler(serial_, *proxy::wrapper_cast<surface>(surface_), *keys_);
+        handler(serial_, *proxy::wrapper_cast<surface>(data, surface_), array_view<const uint32_t>(*keys_));
     }
 }
 
 void keyboard::leave_handler(void* data, wl_proxy* wl_obj, uint32_t serial_, wl_proxy* surface_) {
     auto& handler = proxy::user_data_to_wrapper_cast<keyboard>(data)->_leave_handler;
     if(handler) {
-        handler(serial_, *proxy::wrapper_cast<surface>(surface_));
+        handler(serial_, *proxy::wrapper_cast<surface>(data, surface_));
     }
 }
 
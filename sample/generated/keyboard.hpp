@@ -3,9 +3,14 @@
 #define _KEYBOARD_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,28 +42,6 @@
 
 namespace wlcpp {
 
-class surface;
-
-#define WLCPP_KEYBOARD_VERSION 3
-
-/** \brief keyboard mapping format
- *
- *  This specifies the format of the keymap provided to the client with the
- *  wl_keyboard.keymap event.
- */
-enum keyboard_keymap_format {
-    KEYBOARD_KEYMAP_FORMAT_NO_KEYMAP = 0, /**< no keymap; client must understand how to interpret the raw keycode */
-    KEYBOARD_KEYMAP_FORMAT_XKB_V1 = 1, /**< libxkbcommon compatible */
-};
-
-/** \brief physical key state
- *
- *  Describes the physical state of a key which provoked the key event.
- */
-enum keyboard_key_state {
-    KEYBOARD_KEY_STATE_RELEASED = 0, /**< key is not pressed */
-    KEYBOARD_KEY_STATE_PRESSED = 1, /**< key is pressed */
-};
 
 /** \brief keyboard input device
  *
@@ -66,7 +49,7 @@ enum keyboard_key_state {
  *  seat.
  */
 class keyboard final
-    : public proxy {
+    : public proxy_base<keyboard> {
 public:
     /** \brief wl_interface for @ref keyboard */
     static const wl_interface interface;
@@ -74,6 +57,9 @@ public:
     /** \brief @ref keyboard version at wrapper generation time */
     static constexpr std::uint32_t version = 3;
 
+    /** \brief Opcode of the destructor request of @ref keyboard, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 0;
+
     /** \brief Wrap existing wl_keyboard object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_keyboard object and is responsible for destryoing it
@@ -89,7 +75,7 @@ public:
     keyboard(keyboard&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~keyboard();
+    ~keyboard();
 
     /** \brief Default move assignment operator */
     keyboard& operator=(keyboard&& rhs) = default;
@@ -110,7 +96,7 @@ public:
      */
     template <typename T>
     void set_keymap_handler(T&& handler) {
-        _keymap_handler = std::function<keymap_handler_sig>(std::forward<T>(handler));
+        _keymap_handler = delegate<keymap_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief enter event
@@ -121,14 +107,14 @@ public:
      *  @param surface_
      *  @param keys_ the currently pressed keys
      */
-    using enter_handler_sig = void (std::uint32_t serial_, surface& surface_, const wl_array& keys_);
+    using enter_handler_sig = void (std::uint32_t serial_, surface& surface_, array_view<const std::uint32_t> keys_);
 
     /** \brief Set a handler for the enter event
      *  @param handler Callable of signature @ref enter_handler_sig
      */
     template <typename T>
     void set_enter_handler(T&& handler) {
-        _enter_handler = std::function<enter_handler_sig>(std::forward<T>(handler));
+        _enter_handler = delegate<enter_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief leave event
@@ -149,7 +135,7 @@ public:
      */
     template <typename T>
     void set_leave_handler(T&& handler) {
-        _leave_handler = std::function<leave_handler_sig>(std::forward<T>(handler));
+        _leave_handler = delegate<leave_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief key event
@@ -169,7 +155,7 @@ public:
      */
     template <typename T>
     void set_key_handler(T&& handler) {
-        _key_handler = std::function<key_handler_sig>(std::forward<T>(handler));
+        _key_handler = delegate<key_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief modifier and group state
@@ -190,11 +176,12 @@ public:
      */
     template <typename T>
     void set_modifiers_handler(T&& handler) {
-        _modifiers_handler = std::function<modifiers_handler_sig>(std::forward<T>(handler));
+        _modifiers_handler = delegate<modifiers_handler_sig>(std::forward<T>(handler));
     }
 
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<keyboard>;
 
 private:
     struct listener_t {
@@ -213,11 +200,13 @@ private:
 
     static const listener_t listener;
 
-    std::function<keymap_handler_sig> _keymap_handler;
-    std::function<enter_handler_sig> _enter_handler;
-    std::function<leave_handler_sig> _leave_handler;
-    std::function<key_handler_sig> _key_handler;
-    std::function<modifiers_handler_sig> _modifiers_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<keymap_handler_sig> _keymap_handler;
+    delegate<enter_handler_sig> _enter_handler;
+    delegate<leave_handler_sig> _leave_handler;
+    delegate<key_handler_sig> _key_handler;
+    delegate<modifiers_handler_sig> _modifiers_handler;
 };
 
 } // namespace wlcpp
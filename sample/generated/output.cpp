@@ -32,16 +32,22 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_output_event_geometry_types[] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
-static const wl_interface* wl_output_event_mode_types[] = { nullptr, nullptr, nullptr, nullptr };
-static const wl_interface* wl_output_event_done_types[] = { };
-static const wl_interface* wl_output_event_scale_types[] = { nullptr };
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+};
 
-static const wl_message wl_output_events[] = {
-    { "geometry", "iiiiissi", wl_output_event_geometry_types },
-    { "mode", "uiii", wl_output_event_mode_types },
-    { "done", "2", wl_output_event_done_types },
-    { "scale", "2i", wl_output_event_scale_types },
+static constexpr wl_message wl_output_events[] = {
+    { "geometry", "iiiiissi", message_types + 0 },
+    { "mode", "uiii", message_types + 0 },
+    { "done", "2", message_types + 0 },
+    { "scale", "2i", message_types + 0 },
 };
 
 const wl_interface output::interface = {
@@ -57,14 +63,34 @@ const output::listener_t output::listener = {
     &scale_handler,
 };
 
+int output::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        geometry_handler(data, wl_obj, args[0].i, args[1].i, args[2].i, args[3].i, args[4].i, args[5].s, args[6].s, args[7].i);
+        break;
+    case 1:
+        mode_handler(data, wl_obj, args[0].u, args[1].i, args[2].i, args[3].i);
+        break;
+    case 2:
+        done_handler(data, wl_obj);
+        break;
+    case 3:
+        scale_handler(data, wl_obj, args[0].i);
+        break;
+    }
+    return 0;
+}
+
 output::output(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<output>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 output::output(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<output>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 void output::geometry_handler(void* data, wl_proxy* wl_obj, int32_t x_, int32_t y_, int32_t physical_width_, int32_t physical_height_, int32_t subpixel_, const char* make_, const char* model_, int32_t transform_) {
@@ -3,9 +3,14 @@
 #define _OUTPUT_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -38,55 +43,6 @@
 namespace wlcpp {
 
 
-#define WLCPP_OUTPUT_VERSION 2
-
-/** \brief subpixel geometry information
- *
- *  This enumeration describes how the physical pixels on an output are layed
- *  out.
- */
-enum output_subpixel {
-    OUTPUT_SUBPIXEL_UNKNOWN = 0,
-    OUTPUT_SUBPIXEL_NONE = 1,
-    OUTPUT_SUBPIXEL_HORIZONTAL_RGB = 2,
-    OUTPUT_SUBPIXEL_HORIZONTAL_BGR = 3,
-    OUTPUT_SUBPIXEL_VERTICAL_RGB = 4,
-    OUTPUT_SUBPIXEL_VERTICAL_BGR = 5,
-};
-
-/** \brief transform from framebuffer to output
- *
- *  This describes the transform that a compositor will apply to a surface to
- *  compensate for the rotation or mirroring of an output device.
- *
- *  The flipped values correspond to an initial flip around a vertical axis
- *  followed by rotation.
- *
- *  The purpose is mainly to allow clients render accordingly and tell the
- *  compositor, so that for fullscreen surfaces, the compositor will still be
- *  able to scan out directly from client surfaces.
- */
-enum output_transform {
-    OUTPUT_TRANSFORM_NORMAL = 0,
-    OUTPUT_TRANSFORM_90 = 1,
-    OUTPUT_TRANSFORM_180 = 2,
-    OUTPUT_TRANSFORM_270 = 3,
-    OUTPUT_TRANSFORM_FLIPPED = 4,
-    OUTPUT_TRANSFORM_FLIPPED_90 = 5,
-    OUTPUT_TRANSFORM_FLIPPED_180 = 6,
-    OUTPUT_TRANSFORM_FLIPPED_270 = 7,
-};
-
-/** \brief mode information
- *
- *  These flags describe properties of an output mode. They are used in the
- *  flags bitfield of the mode event.
- */
-enum output_mode {
-    OUTPUT_MODE_CURRENT = 0x1, /**< indicates this is the current mode */
-    OUTPUT_MODE_PREFERRED = 0x2, /**< indicates this is the preferred mode */
-};
-
 /** \brief compositor output region
  *
  *  An output describes part of the compositor geometry. The compositor works in
@@ -96,7 +52,7 @@ enum output_mode {
  *  as global during start up, or when a monitor is hotplugged.
  */
 class output final
-    : public proxy {
+    : public proxy_base<output> {
 public:
     /** \brief wl_interface for @ref output */
     static const wl_interface interface;
@@ -104,6 +60,9 @@ public:
     /** \brief @ref output version at wrapper generation time */
     static constexpr std::uint32_t version = 2;
 
+    /** \brief Opcode of the destructor request of @ref output, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_output object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_output object and is responsible for destryoing it
@@ -119,7 +78,7 @@ public:
     output(output&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~output() = default;
+    ~output() = default;
 
     /** \brief Default move assignment operator */
     output& operator=(output&& rhs) = default;
@@ -139,14 +98,14 @@ public:
      *  @param model_ textual description of the model
      *  @param transform_ transform that maps framebuffer to output
      */
-    using geometry_handler_sig = void (std::int32_t x_, std::int32_t y_, std::int32_t physical_width_, std::int32_t physical_height_, std::int32_t subpixel_, const std::string& make_, const std::string& model_, std::int32_t transform_);
+    using geometry_handler_sig = void (std::int32_t x_, std::int32_t y_, std::int32_t physical_width_, std::int32_t physical_height_, std::int32_t subpixel_, string_ref make_, string_ref model_, std::int32_t transform_);
 
     /** \brief Set a handler for the geometry event
      *  @param handler Callable of signature @ref geometry_handler_sig
      */
     template <typename T>
     void set_geometry_handler(T&& handler) {
-        _geometry_handler = std::function<geometry_handler_sig>(std::forward<T>(handler));
+        _geometry_handler = delegate<geometry_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief advertise available modes for the output
@@ -175,7 +134,7 @@ public:
      */
     template <typename T>
     void set_mode_handler(T&& handler) {
-        _mode_handler = std::function<mode_handler_sig>(std::forward<T>(handler));
+        _mode_handler = delegate<mode_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief sent all information about output
@@ -192,7 +151,7 @@ public:
      */
     template <typename T>
     void set_done_handler(T&& handler) {
-        _done_handler = std::function<done_handler_sig>(std::forward<T>(handler));
+        _done_handler = delegate<done_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief output scaling properties
@@ -221,7 +180,7 @@ public:
      */
     template <typename T>
     void set_scale_handler(T&& handler) {
-        _scale_handler = std::function<scale_handler_sig>(std::forward<T>(handler));
+        _scale_handler = delegate<scale_handler_sig>(std::forward<T>(handler));
     }
 
 private:
@@ -239,10 +198,12 @@ private:
 
     static const listener_t listener;
 
-    std::function<geometry_handler_sig> _geometry_handler;
-    std::function<mode_handler_sig> _mode_handler;
-    std::function<done_handler_sig> _done_handler;
-    std::function<scale_handler_sig> _scale_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<geometry_handler_sig> _geometry_handler;
+    delegate<mode_handler_sig> _mode_handler;
+    delegate<done_handler_sig> _done_handler;
+    delegate<scale_handler_sig> _scale_handler;
 };
 
 } // namespace wlcpp
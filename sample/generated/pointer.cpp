@@ -33,26 +33,28 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_pointer_request_set_cursor_types[] = { nullptr, &surface::interface, nullptr, nullptr };
-static const wl_interface* wl_pointer_request_release_types[] = { };
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    &surface::interface,
+    nullptr,
+    nullptr,
+};
 
-static const wl_message wl_pointer_requests[] = {
-    { "set_cursor", "u?oii", wl_pointer_request_set_cursor_types },
-    { "release", "3", wl_pointer_request_release_types },
+static constexpr wl_message wl_pointer_requests[] = {
+    { "set_cursor", "u?oii", message_types + 4 },
+    { "release", "3", message_types + 0 },
 };
 
-static const wl_interface* wl_pointer_event_enter_types[] = { nullptr, &surface::interface, nullptr, nullptr };
-static const wl_interface* wl_pointer_event_leave_types[] = { nullptr, &surface::interface };
-static const wl_interface* wl_pointer_event_motion_types[] = { nullptr, nullptr, nullptr };
-static const wl_interface* wl_pointer_event_button_types[] = { nullptr, nullptr, nullptr, nullptr };
-static const wl_interface* wl_pointer_event_axis_types[] = { nullptr, nullptr, nullptr };
-
-static const wl_message wl_pointer_events[] = {
-    { "enter", "uoff", wl_pointer_event_enter_types },
-    { "leave", "uo", wl_pointer_event_leave_types },
-    { "motion", "uff", wl_pointer_event_motion_types },
-    { "button", "uuuu", wl_pointer_event_button_types },
-    { "axis", "uuf", wl_pointer_event_axis_types },
+static constexpr wl_message wl_pointer_events[] = {
+    { "enter", "uoff", message_types + 4 },
+    { "leave", "uo", message_types + 4 },
+    { "motion", "uff", message_types + 0 },
+    { "button", "uuuu", message_types + 0 },
+    { "axis", "uuf", message_types + 0 },
 };
 
 const wl_interface pointer::interface = {
@@ -69,14 +71,37 @@ const pointer::listener_t pointer::listener = {
     &axis_handler,
 };
 
+int pointer::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        enter_handler(data, wl_obj, args[0].u, reinterpret_cast<wl_proxy*>(args[1].o), args[2].f, args[3].f);
+        break;
+    case 1:
+        leave_handler(data, wl_obj, args[0].u, reinterpret_cast<wl_proxy*>(args[1].o));
+        break;
+    case 2:
+        motion_handler(data, wl_obj, args[0].u, args[1].f, args[2].f);
+        break;
+    case 3:
+        button_handler(data, wl_obj, args[0].u, args[1].u, args[2].u, args[3].u);
+        break;
+    case 4:
+        axis_handler(data, wl_obj, args[0].u, args[1].u, args[2].f);
+        break;
+    }
+    return 0;
+}
+
 pointer::pointer(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<pointer>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 pointer::pointer(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<pointer>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 pointer::~pointer(){
@@ -84,12 +109,17 @@ pointer::~pointer(){
 }
 
 void pointer::set_cursor(uint32_t serial_, surface* surface_, int32_t hotspot_x_, int32_t hotspot_y_) {
-    marshal(0, serial_, surface_ ? surface_->wl_obj() : nullptr, hotspot_x_, hotspot_y_);
+    wl_argument args[4];
+    args[0].u = serial_;
+    args[1].o = surface_ ? reinterpret_cast<wl_object*>(surface_->wl_obj()) : nullptr;
+    args[2].i = hotspot_x_;
+    args[3].i = hotspot_y_;
+    marshal_array(0, args, interface.methods[0]);
 }
 
 void pointer::destroy() {
     if(valid() && managed()) {
-        marshal(1);
+        marshal_array(1, nullptr, interface.methods[1]);
     }
     proxy::destroy();
 }
@@ -97,14 +127,14 @@ void pointer::destroy() {
 void pointer::enter_handler(void* data, wl_proxy* wl_obj, uint32_t serial_, wl_proxy* surface_, wl_fixed_t surface_x_, wl_fixed_t surface_y_) {
     auto& handler = proxy::user_data_to_wrapper_cast<pointer>(data)->_enter_handler;
     if(handler) {
-        handler(serial_, *proxy::wrapper_cast<surface>(surface_), surface_x_, surface_y_);
+        handler(serial_, *proxy::wrapper_cast<surface>(data, surface_), surface_x_, surface_y_);
     }
 }
 
 void pointer::leave_handler(void* data, wl_proxy* wl_obj, uint32_t serial_, wl_proxy* surface_) {
     auto& handler = proxy::user_data_to_wrapper_cast<pointer>(data)->_leave_handler;
     if(handler) {
-        handler(serial_, *proxy::wrapper_cast<surface>(surface_));
+        handler(serial_, *proxy::wrapper_cast<surface>(data, surface_));
     }
 }
 
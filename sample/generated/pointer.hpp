@@ -3,9 +3,14 @@
 #define _POINTER_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,27 +42,6 @@
 
 namespace wlcpp {
 
-class surface;
-
-#define WLCPP_POINTER_VERSION 3
-
-/** \brief physical button state
- *
- *  Describes the physical state of a button which provoked the button event.
- */
-enum pointer_button_state {
-    POINTER_BUTTON_STATE_RELEASED = 0, /**< The button is not pressed */
-    POINTER_BUTTON_STATE_PRESSED = 1, /**< The button is pressed */
-};
-
-/** \brief axis types
- *
- *  Describes the axis types of scroll events.
- */
-enum pointer_axis {
-    POINTER_AXIS_VERTICAL_SCROLL = 0,
-    POINTER_AXIS_HORIZONTAL_SCROLL = 1,
-};
 
 /** \brief pointer input device
  *
@@ -69,7 +53,7 @@ enum pointer_axis {
  *  button presses, button releases and scrolling.
  */
 class pointer final
-    : public proxy {
+    : public proxy_base<pointer> {
 public:
     /** \brief wl_interface for @ref pointer */
     static const wl_interface interface;
@@ -77,6 +61,9 @@ public:
     /** \brief @ref pointer version at wrapper generation time */
     static constexpr std::uint32_t version = 3;
 
+    /** \brief Opcode of the destructor request of @ref pointer, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 1;
+
     /** \brief Wrap existing wl_pointer object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_pointer object and is responsible for destryoing it
@@ -92,7 +79,7 @@ public:
     pointer(pointer&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~pointer();
+    ~pointer();
 
     /** \brief Default move assignment operator */
     pointer& operator=(pointer&& rhs) = default;
@@ -130,6 +117,28 @@ public:
      */
     void set_cursor(std::uint32_t serial_, surface* surface_, std::int32_t hotspot_x_, std::int32_t hotspot_y_);
 
+    /** \brief Arguments of @ref set_cursor, objects are passed as native objects */
+    struct set_cursor_args {
+        static constexpr std::uint32_t opcode = 0;
+        static constexpr std::uint32_t arg_count = 4;
+
+        std::uint32_t serial_;
+        wl_proxy* surface_;
+        std::int32_t hotspot_x_;
+        std::int32_t hotspot_y_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].u = serial_;
+            args[1].o = reinterpret_cast<wl_object*>(surface_);
+            args[2].i = hotspot_x_;
+            args[3].i = hotspot_y_;
+        }
+    };
+
     /** \brief enter event
      *
      *  Notification that this seat's pointer is focused on a certain surface.
@@ -150,7 +159,7 @@ public:
      */
     template <typename T>
     void set_enter_handler(T&& handler) {
-        _enter_handler = std::function<enter_handler_sig>(std::forward<T>(handler));
+        _enter_handler = delegate<enter_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief leave event
@@ -171,7 +180,7 @@ public:
      */
     template <typename T>
     void set_leave_handler(T&& handler) {
-        _leave_handler = std::function<leave_handler_sig>(std::forward<T>(handler));
+        _leave_handler = delegate<leave_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief pointer motion event
@@ -190,7 +199,7 @@ public:
      */
     template <typename T>
     void set_motion_handler(T&& handler) {
-        _motion_handler = std::function<motion_handler_sig>(std::forward<T>(handler));
+        _motion_handler = delegate<motion_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief pointer button event
@@ -213,7 +222,7 @@ public:
      */
     template <typename T>
     void set_button_handler(T&& handler) {
-        _button_handler = std::function<button_handler_sig>(std::forward<T>(handler));
+        _button_handler = delegate<button_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief axis event
@@ -246,11 +255,12 @@ public:
      */
     template <typename T>
     void set_axis_handler(T&& handler) {
-        _axis_handler = std::function<axis_handler_sig>(std::forward<T>(handler));
+        _axis_handler = delegate<axis_handler_sig>(std::forward<T>(handler));
     }
 
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<pointer>;
 
 private:
     struct listener_t {
@@ -269,11 +279,13 @@ private:
 
     static const listener_t listener;
 
-    std::function<enter_handler_sig> _enter_handler;
-    std::function<leave_handler_sig> _leave_handler;
-    std::function<motion_handler_sig> _motion_handler;
-    std::function<button_handler_sig> _button_handler;
-    std::function<axis_handler_sig> _axis_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<enter_handler_sig> _enter_handler;
+    delegate<leave_handler_sig> _leave_handler;
+    delegate<motion_handler_sig> _motion_handler;
+    delegate<button_handler_sig> _button_handler;
+    delegate<axis_handler_sig> _axis_handler;
 };
 
 } // namespace wlcpp
@@ -32,14 +32,17 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_region_request_destroy_types[] = { };
-static const wl_interface* wl_region_request_add_types[] = { nullptr, nullptr, nullptr, nullptr };
-static const wl_interface* wl_region_request_subtract_types[] = { nullptr, nullptr, nullptr, nullptr };
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+};
 
-static const wl_message wl_region_requests[] = {
-    { "destroy", "", wl_region_request_destroy_types },
-    { "add", "iiii", wl_region_request_add_types },
-    { "subtract", "iiii", wl_region_request_subtract_types },
+static constexpr wl_message wl_region_requests[] = {
+    { "destroy", "", message_types + 0 },
+    { "add", "iiii", message_types + 0 },
+    { "subtract", "iiii", message_types + 0 },
 };
 
 const wl_interface region::interface = {
@@ -49,11 +52,11 @@ const wl_interface region::interface = {
 };
 
 region::region(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
+    : proxy_base<region>(obj, managed) {
 }
 
 region::region(proxy& factory)
-    : proxy(factory, interface) {
+    : proxy_base<region>(factory, interface) {
 }
 
 region::~region(){
@@ -61,16 +64,26 @@ region::~region(){
 }
 
 void region::add(int32_t x_, int32_t y_, int32_t width_, int32_t height_) {
-    marshal(1, x_, y_, width_, height_);
+    wl_argument args[4];
+    args[0].i = x_;
+    args[1].i = y_;
+    args[2].i = width_;
+    args[3].i = height_;
+    marshal_array(1, args, interface.methods[1]);
 }
 
 void region::subtract(int32_t x_, int32_t y_, int32_t width_, int32_t height_) {
-    marshal(2, x_, y_, width_, height_);
+    wl_argument args[4];
+    args[0].i = x_;
+    args[1].i = y_;
+    args[2].i = width_;
+    args[3].i = height_;
+    marshal_array(2, args, interface.methods[2]);
 }
 
 void region::destroy() {
     if(valid() && managed()) {
-        marshal(0);
+        marshal_array(0, nullptr, interface.methods[0]);
     }
     proxy::destroy();
 }
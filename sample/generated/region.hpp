@@ -3,9 +3,14 @@
 #define _REGION_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -38,8 +43,6 @@
 namespace wlcpp {
 
 
-#define WLCPP_REGION_VERSION 1
-
 /** \brief region interface
  *
  *  A region object describes an area.
@@ -48,7 +51,7 @@ namespace wlcpp {
  *  surface.
  */
 class region final
-    : public proxy {
+    : public proxy_base<region> {
 public:
     /** \brief wl_interface for @ref region */
     static const wl_interface interface;
@@ -56,6 +59,9 @@ public:
     /** \brief @ref region version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref region, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 0;
+
     /** \brief Wrap existing wl_region object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_region object and is responsible for destryoing it
@@ -71,7 +77,7 @@ public:
     region(region&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~region();
+    ~region();
 
     /** \brief Default move assignment operator */
     region& operator=(region&& rhs) = default;
@@ -87,6 +93,28 @@ public:
      */
     void add(std::int32_t x_, std::int32_t y_, std::int32_t width_, std::int32_t height_);
 
+    /** \brief Arguments of @ref add, objects are passed as native objects */
+    struct add_args {
+        static constexpr std::uint32_t opcode = 1;
+        static constexpr std::uint32_t arg_count = 4;
+
+        std::int32_t x_;
+        std::int32_t y_;
+        std::int32_t width_;
+        std::int32_t height_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].i = x_;
+            args[1].i = y_;
+            args[2].i = width_;
+            args[3].i = height_;
+        }
+    };
+
     /** \brief subtract rectangle from region
      *
      *  Subtract the specified rectangle from the region.
@@ -98,8 +126,31 @@ public:
      */
     void subtract(std::int32_t x_, std::int32_t y_, std::int32_t width_, std::int32_t height_);
 
+    /** \brief Arguments of @ref subtract, objects are passed as native objects */
+    struct subtract_args {
+        static constexpr std::uint32_t opcode = 2;
+        static constexpr std::uint32_t arg_count = 4;
+
+        std::int32_t x_;
+        std::int32_t y_;
+        std::int32_t width_;
+        std::int32_t height_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].i = x_;
+            args[1].i = y_;
+            args[2].i = width_;
+            args[3].i = height_;
+        }
+    };
+
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<region>;
 };
 
 } // namespace wlcpp
@@ -32,18 +32,20 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_registry_request_bind_types[] = { nullptr, nullptr, nullptr, nullptr };
-
-static const wl_message wl_registry_requests[] = {
-    { "bind", "usun", wl_registry_request_bind_types },
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
 };
 
-static const wl_interface* wl_registry_event_global_types[] = { nullptr, nullptr, nullptr };
-static const wl_interface* wl_registry_event_global_remove_types[] = { nullptr };
+static constexpr wl_message wl_registry_requests[] = {
+    { "bind", "usun", message_types + 0 },
+};
 
-static const wl_message wl_registry_events[] = {
-    { "global", "usu", wl_registry_event_global_types },
-    { "global_remove", "u", wl_registry_event_global_remove_types },
+static constexpr wl_message wl_registry_events[] = {
+    { "global", "usu", message_types + 0 },
+    { "global_remove", "u", message_types + 0 },
 };
 
 const wl_interface registry::interface = {
@@ -57,14 +59,28 @@ const registry::listener_t registry::listener = {
     &global_remove_handler,
 };
 
+int registry::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        global_handler(data, wl_obj, args[0].u, args[1].s, args[2].u);
+        break;
+    case 1:
+        global_remove_handler(data, wl_obj, args[0].u);
+        break;
+    }
+    return 0;
+}
+
 registry::registry(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<registry>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 registry::registry(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<registry>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 void registry::global_handler(void* data, wl_proxy* wl_obj, uint32_t name_, const char* interface_, uint32_t version_) {
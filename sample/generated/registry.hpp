@@ -3,9 +3,14 @@
 #define _REGISTRY_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -38,8 +43,6 @@
 namespace wlcpp {
 
 
-#define WLCPP_REGISTRY_VERSION 1
-
 /** \brief global registry object
  *
  *  The global registry object. The server has a number of global objects that
@@ -60,7 +63,7 @@ namespace wlcpp {
  *  the client invoke requests on the object.
  */
 class registry final
-    : public proxy {
+    : public proxy_base<registry> {
 public:
     /** \brief wl_interface for @ref registry */
     static const wl_interface interface;
@@ -68,6 +71,9 @@ public:
     /** \brief @ref registry version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref registry, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_registry object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_registry object and is responsible for destryoing it
@@ -83,7 +89,7 @@ public:
     registry(registry&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~registry() = default;
+    ~registry() = default;
 
     /** \brief Default move assignment operator */
     registry& operator=(registry&& rhs) = default;
@@ -99,9 +105,12 @@ public:
      */
     template <typename T>
     T bind(std::uint32_t name_, std::uint32_t version_) {
-        T id_(*this);
-        marshal(0, name_, T::interface.name, version_, id_.wl_obj());
-        return id_;
+        wl_argument args[4];
+        args[0].u = name_;
+        args[1].s = T::interface.name;
+        args[2].u = version_;
+        args[3].o = nullptr;
+        return wrap<T>(marshal_array_constructor_versioned(0, args, T::interface, version_, interface.methods[0]));
     }
 
     /** \brief announce global object
@@ -115,14 +124,14 @@ public:
      *  @param interface_
      *  @param version_
      */
-    using global_handler_sig = void (std::uint32_t name_, const std::string& interface_, std::uint32_t version_);
+    using global_handler_sig = void (std::uint32_t name_, string_ref interface_, std::uint32_t version_);
 
     /** \brief Set a handler for the global event
      *  @param handler Callable of signature @ref global_handler_sig
      */
     template <typename T>
     void set_global_handler(T&& handler) {
-        _global_handler = std::function<global_handler_sig>(std::forward<T>(handler));
+        _global_handler = delegate<global_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief announce removal of global object
@@ -146,7 +155,7 @@ public:
      */
     template <typename T>
     void set_global_remove_handler(T&& handler) {
-        _global_remove_handler = std::function<global_remove_handler_sig>(std::forward<T>(handler));
+        _global_remove_handler = delegate<global_remove_handler_sig>(std::forward<T>(handler));
     }
 
 private:
@@ -160,8 +169,10 @@ private:
 
     static const listener_t listener;
 
-    std::function<global_handler_sig> _global_handler;
-    std::function<global_remove_handler_sig> _global_remove_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<global_handler_sig> _global_handler;
+    delegate<global_remove_handler_sig> _global_remove_handler;
 };
 
 } // namespace wlcpp
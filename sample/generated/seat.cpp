@@ -35,22 +35,22 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_seat_request_get_pointer_types[] = { &pointer::interface };
-static const wl_interface* wl_seat_request_get_keyboard_types[] = { &keyboard::interface };
-static const wl_interface* wl_seat_request_get_touch_types[] = { &touch::interface };
-
-static const wl_message wl_seat_requests[] = {
-    { "get_pointer", "n", wl_seat_request_get_pointer_types },
-    { "get_keyboard", "n", wl_seat_request_get_keyboard_types },
-    { "get_touch", "n", wl_seat_request_get_touch_types },
+static const wl_interface* message_types[] = {
+    nullptr,
+    &pointer::interface,
+    &keyboard::interface,
+    &touch::interface,
 };
 
-static const wl_interface* wl_seat_event_capabilities_types[] = { nullptr };
-static const wl_interface* wl_seat_event_name_types[] = { nullptr };
+static constexpr wl_message wl_seat_requests[] = {
+    { "get_pointer", "n", message_types + 1 },
+    { "get_keyboard", "n", message_types + 2 },
+    { "get_touch", "n", message_types + 3 },
+};
 
-static const wl_message wl_seat_events[] = {
-    { "capabilities", "u", wl_seat_event_capabilities_types },
-    { "name", "2s", wl_seat_event_name_types },
+static constexpr wl_message wl_seat_events[] = {
+    { "capabilities", "u", message_types + 0 },
+    { "name", "2s", message_types + 0 },
 };
 
 const wl_interface seat::interface = {
@@ -64,32 +64,46 @@ const seat::listener_t seat::listener = {
     &name_handler,
 };
 
+int seat::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        capabilities_handler(data, wl_obj, args[0].u);
+        break;
+    case 1:
+        name_handler(data, wl_obj, args[0].s);
+        break;
+    }
+    return 0;
+}
+
 seat::seat(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<seat>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 seat::seat(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<seat>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 pointer seat::get_pointer() {
-    pointer id_(*this);
-    marshal(0, id_.wl_obj());
-    return id_;
+    wl_argument args[1];
+    args[0].o = nullptr;
+    return wrap<pointer>(marshal_array_constructor(0, args, pointer::interface, interface.methods[0]));
 }
 
 keyboard seat::get_keyboard() {
-    keyboard id_(*this);
-    marshal(1, id_.wl_obj());
-    return id_;
+    wl_argument args[1];
+    args[0].o = nullptr;
+    return wrap<keyboard>(marshal_array_constructor(1, args, keyboard::interface, interface.methods[1]));
 }
 
 touch seat::get_touch() {
-    touch id_(*this);
-    marshal(2, id_.wl_obj());
-    return id_;
+    wl_argument args[1];
+    args[0].o = nullptr;
+    return wrap<touch>(marshal_array_constructor(2, args, touch::interface, interface.methods[2]));
 }
 
 void seat::capabilities_handler(void* data, wl_proxy* wl_obj, uint32_t capabilities_) {
@@ -3,9 +3,14 @@
 #define _SEAT_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,22 +42,6 @@
 
 namespace wlcpp {
 
-class keyboard;
-class pointer;
-class touch;
-
-#define WLCPP_SEAT_VERSION 3
-
-/** \brief seat capability bitmask
- *
- *  This is a bitmask of capabilities this seat has; if a member is set, then it
- *  is present on the seat.
- */
-enum seat_capability {
-    SEAT_CAPABILITY_POINTER = 1, /**< The seat has pointer devices */
-    SEAT_CAPABILITY_KEYBOARD = 2, /**< The seat has one or more keyboards */
-    SEAT_CAPABILITY_TOUCH = 4, /**< The seat has touch devices */
-};
 
 /** \brief group of input devices
  *
@@ -62,7 +51,7 @@ enum seat_capability {
  *  focus.
  */
 class seat final
-    : public proxy {
+    : public proxy_base<seat> {
 public:
     /** \brief wl_interface for @ref seat */
     static const wl_interface interface;
@@ -70,6 +59,9 @@ public:
     /** \brief @ref seat version at wrapper generation time */
     static constexpr std::uint32_t version = 3;
 
+    /** \brief Opcode of the destructor request of @ref seat, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_seat object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_seat object and is responsible for destryoing it
@@ -85,7 +77,7 @@ public:
     seat(seat&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~seat() = default;
+    ~seat() = default;
 
     /** \brief Default move assignment operator */
     seat& operator=(seat&& rhs) = default;
@@ -137,7 +129,7 @@ public:
      */
     template <typename T>
     void set_capabilities_handler(T&& handler) {
-        _capabilities_handler = std::function<capabilities_handler_sig>(std::forward<T>(handler));
+        _capabilities_handler = delegate<capabilities_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief unique identifier for this seat
@@ -148,14 +140,14 @@ public:
      *
      *  @param name_
      */
-    using name_handler_sig = void (const std::string& name_);
+    using name_handler_sig = void (string_ref name_);
 
     /** \brief Set a handler for the name event
      *  @param handler Callable of signature @ref name_handler_sig
      */
     template <typename T>
     void set_name_handler(T&& handler) {
-        _name_handler = std::function<name_handler_sig>(std::forward<T>(handler));
+        _name_handler = delegate<name_handler_sig>(std::forward<T>(handler));
     }
 
 private:
@@ -169,8 +161,10 @@ private:
 
     static const listener_t listener;
 
-    std::function<capabilities_handler_sig> _capabilities_handler;
-    std::function<name_handler_sig> _name_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<capabilities_handler_sig> _capabilities_handler;
+    delegate<name_handler_sig> _name_handler;
 };
 
 } // namespace wlcpp
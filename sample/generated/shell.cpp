@@ -34,10 +34,14 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_shell_request_get_shell_surface_types[] = { &shell_surface::interface, &surface::interface };
+static const wl_interface* message_types[] = {
+    nullptr,
+    &shell_surface::interface,
+    &surface::interface,
+};
 
-static const wl_message wl_shell_requests[] = {
-    { "get_shell_surface", "no", wl_shell_request_get_shell_surface_types },
+static constexpr wl_message wl_shell_requests[] = {
+    { "get_shell_surface", "no", message_types + 1 },
 };
 
 const wl_interface shell::interface = {
@@ -47,16 +51,17 @@ const wl_interface shell::interface = {
 };
 
 shell::shell(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
+    : proxy_base<shell>(obj, managed) {
 }
 
 shell::shell(proxy& factory)
-    : proxy(factory, interface) {
+    : proxy_base<shell>(factory, interface) {
 }
 
 shell_surface shell::get_shell_surface(surface& surface_) {
-    shell_surface id_(*this);
-    marshal(0, id_.wl_obj(), surface_.wl_obj());
-    return id_;
+    wl_argument args[2];
+    args[0].o = nullptr;
+    args[1].o = reinterpret_cast<wl_object*>(surface_.wl_obj());
+    return wrap<shell_surface>(marshal_array_constructor(0, args, shell_surface::interface, interface.methods[0]));
 }
 
@@ -3,9 +3,14 @@
 #define _SHELL_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,10 +42,6 @@
 
 namespace wlcpp {
 
-class shell_surface;
-class surface;
-
-#define WLCPP_SHELL_VERSION 1
 
 /** \brief create desktop-style surfaces
  *
@@ -50,7 +51,7 @@ class surface;
  *  It allows clients to associate a wl_shell_surface with a basic surface.
  */
 class shell final
-    : public proxy {
+    : public proxy_base<shell> {
 public:
     /** \brief wl_interface for @ref shell */
     static const wl_interface interface;
@@ -58,6 +59,9 @@ public:
     /** \brief @ref shell version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref shell, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_shell object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_shell object and is responsible for destryoing it
@@ -73,7 +77,7 @@ public:
     shell(shell&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~shell() = default;
+    ~shell() = default;
 
     /** \brief Default move assignment operator */
     shell& operator=(shell&& rhs) = default;
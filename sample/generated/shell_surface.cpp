@@ -35,38 +35,47 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_shell_surface_request_pong_types[] = { nullptr };
-static const wl_interface* wl_shell_surface_request_move_types[] = { &seat::interface, nullptr };
-static const wl_interface* wl_shell_surface_request_resize_types[] = { &seat::interface, nullptr, nullptr };
-static const wl_interface* wl_shell_surface_request_set_toplevel_types[] = { };
-static const wl_interface* wl_shell_surface_request_set_transient_types[] = { &surface::interface, nullptr, nullptr, nullptr };
-static const wl_interface* wl_shell_surface_request_set_fullscreen_types[] = { nullptr, nullptr, &output::interface };
-static const wl_interface* wl_shell_surface_request_set_popup_types[] = { &seat::interface, nullptr, &surface::interface, nullptr, nullptr, nullptr };
-static const wl_interface* wl_shell_surface_request_set_maximized_types[] = { &output::interface };
-static const wl_interface* wl_shell_surface_request_set_title_types[] = { nullptr };
-static const wl_interface* wl_shell_surface_request_set_class_types[] = { nullptr };
-
-static const wl_message wl_shell_surface_requests[] = {
-    { "pong", "u", wl_shell_surface_request_pong_types },
-    { "move", "ou", wl_shell_surface_request_move_types },
-    { "resize", "ouu", wl_shell_surface_request_resize_types },
-    { "set_toplevel", "", wl_shell_surface_request_set_toplevel_types },
-    { "set_transient", "oiiu", wl_shell_surface_request_set_transient_types },
-    { "set_fullscreen", "uu?o", wl_shell_surface_request_set_fullscreen_types },
-    { "set_popup", "ouoiiu", wl_shell_surface_request_set_popup_types },
-    { "set_maximized", "?o", wl_shell_surface_request_set_maximized_types },
-    { "set_title", "s", wl_shell_surface_request_set_title_types },
-    { "set_class", "s", wl_shell_surface_request_set_class_types },
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    &seat::interface,
+    nullptr,
+    &seat::interface,
+    nullptr,
+    nullptr,
+    &surface::interface,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    &output::interface,
+    &seat::interface,
+    nullptr,
+    &surface::interface,
+    nullptr,
+    nullptr,
+    nullptr,
 };
 
-static const wl_interface* wl_shell_surface_event_ping_types[] = { nullptr };
-static const wl_interface* wl_shell_surface_event_configure_types[] = { nullptr, nullptr, nullptr };
-static const wl_interface* wl_shell_surface_event_popup_done_types[] = { };
+static constexpr wl_message wl_shell_surface_requests[] = {
+    { "pong", "u", message_types + 0 },
+    { "move", "ou", message_types + 3 },
+    { "resize", "ouu", message_types + 5 },
+    { "set_toplevel", "", message_types + 0 },
+    { "set_transient", "oiiu", message_types + 8 },
+    { "set_fullscreen", "uu?o", message_types + 12 },
+    { "set_popup", "ouoiiu", message_types + 15 },
+    { "set_maximized", "?o", message_types + 14 },
+    { "set_title", "s", message_types + 0 },
+    { "set_class", "s", message_types + 0 },
+};
 
-static const wl_message wl_shell_surface_events[] = {
-    { "ping", "u", wl_shell_surface_event_ping_types },
-    { "configure", "uii", wl_shell_surface_event_configure_types },
-    { "popup_done", "", wl_shell_surface_event_popup_done_types },
+static constexpr wl_message wl_shell_surface_events[] = {
+    { "ping", "u", message_types + 0 },
+    { "configure", "uii", message_types + 0 },
+    { "popup_done", "", message_types + 0 },
 };
 
 const wl_interface shell_surface::interface = {
@@ -81,54 +90,102 @@ const shell_surface::listener_t shell_surface::listener = {
     &popup_done_handler,
 };
 
+int shell_surface::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        ping_handler(data, wl_obj, args[0].u);
+        break;
+    case 1:
+        configure_handler(data, wl_obj, args[0].u, args[1].i, args[2].i);
+        break;
+    case 2:
+        popup_done_handler(data, wl_obj);
+        break;
+    }
+    return 0;
+}
+
 shell_surface::shell_surface(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<shell_surface>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 shell_surface::shell_surface(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<shell_surface>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 void shell_surface::pong(uint32_t serial_) {
-    marshal(0, serial_);
+    wl_argument args[1];
+    args[0].u = serial_;
+    marshal_array(0, args, interface.methods[0]);
 }
 
 void shell_surface::move(seat& seat_, uint32_t serial_) {
-    marshal(1, seat_.wl_obj(), serial_);
+    wl_argument args[2];
+    args[0].o = reinterpret_cast<wl_object*>(seat_.wl_obj());
+    args[1].u = serial_;
+    marshal_array(1, args, interface.methods[1]);
 }
 
 void shell_surface::resize(seat& seat_, uint32_t serial_, uint32_t edges_) {
-    marshal(2, seat_.wl_obj(), serial_, edges_);
+    wl_argument args[3];
+    args[0].o = reinterpret_cast<wl_object*>(seat_.wl_obj());
+    args[1].u = serial_;
+    args[2].u = edges_;
+    marshal_array(2, args, interface.methods[2]);
 }
 
 void shell_surface::set_toplevel() {
-    marshal(3);
+    marshal_array(3, nullptr, interface.methods[3]);
 }
 
 void shell_surface::set_transient(surface& parent_, int32_t x_, int32_t y_, uint32_t flags_) {
-    marshal(4, parent_.wl_obj(), x_, y_, flags_);
+    wl_argument args[4];
+    args[0].o = reinterpret_cast<wl_object*>(parent_.wl_obj());
+    args[1].i = x_;
+    args[2].i = y_;
+    args[3].u = flags_;
+    marshal_array(4, args, interface.methods[4]);
 }
 
 void shell_surface::set_fullscreen(uint32_t method_, uint32_t framerate_, output* output_) {
-    marshal(5, method_, framerate_, output_ ? output_->wl_obj() : nullptr);
+    wl_argument args[3];
+    args[0].u = method_;
+    args[1].u = framerate_;
+    args[2].o = output_ ? reinterpret_cast<wl_object*>(output_->wl_obj()) : nullptr;
+    marshal_array(5, args, interface.methods[5]);
 }
 
 void shell_surface::set_popup(seat& seat_, uint32_t serial_, surface& parent_, int32_t x_, int32_t y_, uint32_t flags_) {
-    marshal(6, seat_.wl_obj(), serial_, parent_.wl_obj(), x_, y_, flags_);
+    wl_argument args[6];
+    args[0].o = reinterpret_cast<wl_object*>(seat_.wl_obj());
+    args[1].u = serial_;
+    args[2].o = reinterpret_cast<wl_object*>(parent_.wl_obj());
+    args[3].i = x_;
+    args[4].i = y_;
+    args[5].u = flags_;
+    marshal_array(6, args, interface.methods[6]);
 }
 
 void shell_surface::set_maximized(output* output_) {
-    marshal(7, output_ ? output_->wl_obj() : nullptr);
+    wl_argument args[1];
+    args[0].o = output_ ? reinterpret_cast<wl_object*>(output_->wl_obj()) : nullptr;
+    marshal_array(7, args, interface.methods[7]);
 }
 
 void shell_surface::set_title(const string& title_) {
-    marshal(8, title_.c_str());
+    wl_argument args[1];
+    args[0].s = title_.c_str();
+    marshal_array(8, args, interface.methods[8]);
 }
 
 void shell_surface::set_class(const string& class__) {
-    marshal(9, class__.c_str());
+    wl_argument args[1];
+    args[0].s = class__.c_str();
+    marshal_array(9, args, interface.methods[9]);
 }
 
 void shell_surface::ping_handler(void* data, wl_proxy* wl_obj, uint32_t serial_) {
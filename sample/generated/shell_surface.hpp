@@ -3,9 +3,14 @@
 #define _SHELL_SURFACE_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,51 +42,6 @@
 
 namespace wlcpp {
 
-class output;
-class seat;
-class surface;
-
-#define WLCPP_SHELL_SURFACE_VERSION 1
-
-/** \brief edge values for resizing
- *
- *  These values are used to indicate which edge of a surface is being dragged
- *  in a resize operation. The server may use this information to adapt its
- *  behavior, e.g. choose an appropriate cursor image.
- */
-enum shell_surface_resize {
-    SHELL_SURFACE_RESIZE_NONE = 0,
-    SHELL_SURFACE_RESIZE_TOP = 1,
-    SHELL_SURFACE_RESIZE_BOTTOM = 2,
-    SHELL_SURFACE_RESIZE_LEFT = 4,
-    SHELL_SURFACE_RESIZE_TOP_LEFT = 5,
-    SHELL_SURFACE_RESIZE_BOTTOM_LEFT = 6,
-    SHELL_SURFACE_RESIZE_RIGHT = 8,
-    SHELL_SURFACE_RESIZE_TOP_RIGHT = 9,
-    SHELL_SURFACE_RESIZE_BOTTOM_RIGHT = 10,
-};
-
-/** \brief details of transient behaviour
- *
- *  These flags specify details of the expected behaviour of transient surfaces.
- *  Used in the set_transient request.
- */
-enum shell_surface_transient {
-    SHELL_SURFACE_TRANSIENT_INACTIVE = 0x1, /**< do not set keyboard focus */
-};
-
-/** \brief different method to set the surface fullscreen
- *
- *  Hints to indicate to the compositor how to deal with a conflict between the
- *  dimensions of the surface and the dimensions of the output. The compositor
- *  is free to ignore this parameter.
- */
-enum shell_surface_fullscreen_method {
-    SHELL_SURFACE_FULLSCREEN_METHOD_DEFAULT = 0, /**< no preference, apply default policy */
-    SHELL_SURFACE_FULLSCREEN_METHOD_SCALE = 1, /**< scale, preserve the surface's aspect ratio and center on output */
-    SHELL_SURFACE_FULLSCREEN_METHOD_DRIVER = 2, /**< switch output mode to the smallest mode that can fit the surface, add black borders to compensate size mismatch */
-    SHELL_SURFACE_FULLSCREEN_METHOD_FILL = 3, /**< no upscaling, center on output and add black borders to compensate size mismatch */
-};
 
 /** \brief desktop-style metadata interface
  *
@@ -97,7 +57,7 @@ enum shell_surface_fullscreen_method {
  *  called before destroying the wl_surface object.
  */
 class shell_surface final
-    : public proxy {
+    : public proxy_base<shell_surface> {
 public:
     /** \brief wl_interface for @ref shell_surface */
     static const wl_interface interface;
@@ -105,6 +65,9 @@ public:
     /** \brief @ref shell_surface version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref shell_surface, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_shell_surface object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_shell_surface object and is responsible for destryoing it
@@ -120,7 +83,7 @@ public:
     shell_surface(shell_surface&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~shell_surface() = default;
+    ~shell_surface() = default;
 
     /** \brief Default move assignment operator */
     shell_surface& operator=(shell_surface&& rhs) = default;
@@ -134,6 +97,22 @@ public:
      */
     void pong(std::uint32_t serial_);
 
+    /** \brief Arguments of @ref pong, objects are passed as native objects */
+    struct pong_args {
+        static constexpr std::uint32_t opcode = 0;
+        static constexpr std::uint32_t arg_count = 1;
+
+        std::uint32_t serial_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].u = serial_;
+        }
+    };
+
     /** \brief start an interactive move
      *
      *  Start a pointer-driven move of the surface.
@@ -147,6 +126,24 @@ public:
      */
     void move(seat& seat_, std::uint32_t serial_);
 
+    /** \brief Arguments of @ref move, objects are passed as native objects */
+    struct move_args {
+        static constexpr std::uint32_t opcode = 1;
+        static constexpr std::uint32_t arg_count = 2;
+
+        wl_proxy* seat_;
+        std::uint32_t serial_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(seat_);
+            args[1].u = serial_;
+        }
+    };
+
     /** \brief start an interactive resize
      *
      *  Start a pointer-driven resizing of the surface.
@@ -161,6 +158,26 @@ public:
      */
     void resize(seat& seat_, std::uint32_t serial_, std::uint32_t edges_);
 
+    /** \brief Arguments of @ref resize, objects are passed as native objects */
+    struct resize_args {
+        static constexpr std::uint32_t opcode = 2;
+        static constexpr std::uint32_t arg_count = 3;
+
+        wl_proxy* seat_;
+        std::uint32_t serial_;
+        std::uint32_t edges_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(seat_);
+            args[1].u = serial_;
+            args[2].u = edges_;
+        }
+    };
+
     /** \brief make the surface a toplevel surface
      *
      *  Map the surface as a toplevel surface.
@@ -169,6 +186,19 @@ public:
      */
     void set_toplevel();
 
+    /** \brief Arguments of @ref set_toplevel, objects are passed as native objects */
+    struct set_toplevel_args {
+        static constexpr std::uint32_t opcode = 3;
+        static constexpr std::uint32_t arg_count = 0;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument*) const {
+        }
+    };
+
     /** \brief make the surface a transient surface
      *
      *  Map the surface relative to an existing surface.
@@ -186,6 +216,28 @@ public:
      */
     void set_transient(surface& parent_, std::int32_t x_, std::int32_t y_, std::uint32_t flags_);
 
+    /** \brief Arguments of @ref set_transient, objects are passed as native objects */
+    struct set_transient_args {
+        static constexpr std::uint32_t opcode = 4;
+        static constexpr std::uint32_t arg_count = 4;
+
+        wl_proxy* parent_;
+        std::int32_t x_;
+        std::int32_t y_;
+        std::uint32_t flags_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(parent_);
+            args[1].i = x_;
+            args[2].i = y_;
+            args[3].u = flags_;
+        }
+    };
+
     /** \brief make the surface a fullscreen surface
      *
      *  Map the surface as a fullscreen surface.
@@ -225,6 +277,26 @@ public:
      */
     void set_fullscreen(std::uint32_t method_, std::uint32_t framerate_, output* output_);
 
+    /** \brief Arguments of @ref set_fullscreen, objects are passed as native objects */
+    struct set_fullscreen_args {
+        static constexpr std::uint32_t opcode = 5;
+        static constexpr std::uint32_t arg_count = 3;
+
+        std::uint32_t method_;
+        std::uint32_t framerate_;
+        wl_proxy* output_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].u = method_;
+            args[1].u = framerate_;
+            args[2].o = reinterpret_cast<wl_object*>(output_);
+        }
+    };
+
     /** \brief make the surface a popup surface
      *
      *  Map the surface as a popup.
@@ -253,6 +325,32 @@ public:
      */
     void set_popup(seat& seat_, std::uint32_t serial_, surface& parent_, std::int32_t x_, std::int32_t y_, std::uint32_t flags_);
 
+    /** \brief Arguments of @ref set_popup, objects are passed as native objects */
+    struct set_popup_args {
+        static constexpr std::uint32_t opcode = 6;
+        static constexpr std::uint32_t arg_count = 6;
+
+        wl_proxy* seat_;
+        std::uint32_t serial_;
+        wl_proxy* parent_;
+        std::int32_t x_;
+        std::int32_t y_;
+        std::uint32_t flags_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(seat_);
+            args[1].u = serial_;
+            args[2].o = reinterpret_cast<wl_object*>(parent_);
+            args[3].i = x_;
+            args[4].i = y_;
+            args[5].u = flags_;
+        }
+    };
+
     /** \brief make the surface a maximized surface
      *
      *  Map the surface as a maximized surface.
@@ -276,6 +374,22 @@ public:
      */
     void set_maximized(output* output_);
 
+    /** \brief Arguments of @ref set_maximized, objects are passed as native objects */
+    struct set_maximized_args {
+        static constexpr std::uint32_t opcode = 7;
+        static constexpr std::uint32_t arg_count = 1;
+
+        wl_proxy* output_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(output_);
+        }
+    };
+
     /** \brief set surface title
      *
      *  Set a short title for the surface.
@@ -316,7 +430,7 @@ public:
      */
     template <typename T>
     void set_ping_handler(T&& handler) {
-        _ping_handler = std::function<ping_handler_sig>(std::forward<T>(handler));
+        _ping_handler = delegate<ping_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief suggest resize
@@ -348,7 +462,7 @@ public:
      */
     template <typename T>
     void set_configure_handler(T&& handler) {
-        _configure_handler = std::function<configure_handler_sig>(std::forward<T>(handler));
+        _configure_handler = delegate<configure_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief popup interaction is done
@@ -364,7 +478,7 @@ public:
      */
     template <typename T>
     void set_popup_done_handler(T&& handler) {
-        _popup_done_handler = std::function<popup_done_handler_sig>(std::forward<T>(handler));
+        _popup_done_handler = delegate<popup_done_handler_sig>(std::forward<T>(handler));
     }
 
 private:
@@ -380,9 +494,11 @@ private:
 
     static const listener_t listener;
 
-    std::function<ping_handler_sig> _ping_handler;
-    std::function<configure_handler_sig> _configure_handler;
-    std::function<popup_done_handler_sig> _popup_done_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<ping_handler_sig> _ping_handler;
+    delegate<configure_handler_sig> _configure_handler;
+    delegate<popup_done_handler_sig> _popup_done_handler;
 };
 
 } // namespace wlcpp
@@ -33,16 +33,19 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_shm_request_create_pool_types[] = { &shm_pool::interface, nullptr, nullptr };
-
-static const wl_message wl_shm_requests[] = {
-    { "create_pool", "nhi", wl_shm_request_create_pool_types },
+static const wl_interface* message_types[] = {
+    nullptr,
+    &shm_pool::interface,
+    nullptr,
+    nullptr,
 };
 
-static const wl_interface* wl_shm_event_format_types[] = { nullptr };
+static constexpr wl_message wl_shm_requests[] = {
+    { "create_pool", "nhi", message_types + 1 },
+};
 
-static const wl_message wl_shm_events[] = {
-    { "format", "u", wl_shm_event_format_types },
+static constexpr wl_message wl_shm_events[] = {
+    { "format", "u", message_types + 0 },
 };
 
 const wl_interface shm::interface = {
@@ -55,20 +58,33 @@ const shm::listener_t shm::listener = {
     &format_handler,
 };
 
+int shm::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        format_handler(data, wl_obj, args[0].u);
+        break;
+    }
+    return 0;
+}
+
 shm::shm(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<shm>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 shm::shm(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<shm>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 shm_pool shm::create_pool(int32_t fd_, int32_t size_) {
-    shm_pool id_(*this);
-    marshal(0, id_.wl_obj(), fd_, size_);
-    return id_;
+    wl_argument args[3];
+    args[0].o = nullptr;
+    args[1].h = fd_;
+    args[2].i = size_;
+    return wrap<shm_pool>(marshal_array_constructor(0, args, shm_pool::interface, interface.methods[0]));
 }
 
 void shm::format_handler(void* data, wl_proxy* wl_obj, uint32_t format_) {
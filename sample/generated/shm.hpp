@@ -3,9 +3,14 @@
 #define _SHM_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,87 +42,6 @@
 
 namespace wlcpp {
 
-class shm_pool;
-
-#define WLCPP_SHM_VERSION 1
-
-/** \brief wl_shm error values
- *
- *  These errors can be emitted in response to wl_shm requests.
- */
-enum shm_error {
-    SHM_ERROR_INVALID_FORMAT = 0, /**< buffer format is not known */
-    SHM_ERROR_INVALID_STRIDE = 1, /**< invalid size or stride during pool or buffer creation */
-    SHM_ERROR_INVALID_FD = 2, /**< mmapping the file descriptor failed */
-};
-
-/** \brief pixel formats
- *
- *  This describes the memory layout of an individual pixel.
- *
- *  All renderers should support argb8888 and xrgb8888 but any other formats are
- *  optional and may not be supported by the particular renderer in use.
- */
-enum shm_format {
-    SHM_FORMAT_ARGB8888 = 0, /**< 32-bit ARGB format */
-    SHM_FORMAT_XRGB8888 = 1, /**< 32-bit RGB format */
-    SHM_FORMAT_C8 = 0x20203843,
-    SHM_FORMAT_RGB332 = 0x38424752,
-    SHM_FORMAT_BGR233 = 0x38524742,
-    SHM_FORMAT_XRGB4444 = 0x32315258,
-    SHM_FORMAT_XBGR4444 = 0x32314258,
-    SHM_FORMAT_RGBX4444 = 0x32315852,
-    SHM_FORMAT_BGRX4444 = 0x32315842,
-    SHM_FORMAT_ARGB4444 = 0x32315241,
-    SHM_FORMAT_ABGR4444 = 0x32314241,
-    SHM_FORMAT_RGBA4444 = 0x32314152,
-    SHM_FORMAT_BGRA4444 = 0x32314142,
-    SHM_FORMAT_XRGB1555 = 0x35315258,
-    SHM_FORMAT_XBGR1555 = 0x35314258,
-    SHM_FORMAT_RGBX5551 = 0x35315852,
-    SHM_FORMAT_BGRX5551 = 0x35315842,
-    SHM_FORMAT_ARGB1555 = 0x35315241,
-    SHM_FORMAT_ABGR1555 = 0x35314241,
-    SHM_FORMAT_RGBA5551 = 0x35314152,
-    SHM_FORMAT_BGRA5551 = 0x35314142,
-    SHM_FORMAT_RGB565 = 0x36314752,
-    SHM_FORMAT_BGR565 = 0x36314742,
-    SHM_FORMAT_RGB888 = 0x34324752,
-    SHM_FORMAT_BGR888 = 0x34324742,
-    SHM_FORMAT_XBGR8888 = 0x34324258,
-    SHM_FORMAT_RGBX8888 = 0x34325852,
-    SHM_FORMAT_BGRX8888 = 0x34325842,
-    SHM_FORMAT_ABGR8888 = 0x34324241,
-    SHM_FORMAT_RGBA8888 = 0x34324152,
-    SHM_FORMAT_BGRA8888 = 0x34324142,
-    SHM_FORMAT_XRGB2101010 = 0x30335258,
-    SHM_FORMAT_XBGR2101010 = 0x30334258,
-    SHM_FORMAT_RGBX1010102 = 0x30335852,
-    SHM_FORMAT_BGRX1010102 = 0x30335842,
-    SHM_FORMAT_ARGB2101010 = 0x30335241,
-    SHM_FORMAT_ABGR2101010 = 0x30334241,
-    SHM_FORMAT_RGBA1010102 = 0x30334152,
-    SHM_FORMAT_BGRA1010102 = 0x30334142,
-    SHM_FORMAT_YUYV = 0x56595559,
-    SHM_FORMAT_YVYU = 0x55595659,
-    SHM_FORMAT_UYVY = 0x59565955,
-    SHM_FORMAT_VYUY = 0x59555956,
-    SHM_FORMAT_AYUV = 0x56555941,
-    SHM_FORMAT_NV12 = 0x3231564e,
-    SHM_FORMAT_NV21 = 0x3132564e,
-    SHM_FORMAT_NV16 = 0x3631564e,
-    SHM_FORMAT_NV61 = 0x3136564e,
-    SHM_FORMAT_YUV410 = 0x39565559,
-    SHM_FORMAT_YVU410 = 0x39555659,
-    SHM_FORMAT_YUV411 = 0x31315559,
-    SHM_FORMAT_YVU411 = 0x31315659,
-    SHM_FORMAT_YUV420 = 0x32315559,
-    SHM_FORMAT_YVU420 = 0x32315659,
-    SHM_FORMAT_YUV422 = 0x36315559,
-    SHM_FORMAT_YVU422 = 0x36315659,
-    SHM_FORMAT_YUV444 = 0x34325559,
-    SHM_FORMAT_YVU444 = 0x34325659,
-};
 
 /** \brief shared memory support
  *
@@ -130,7 +54,7 @@ enum shm_format {
  *  buffers.
  */
 class shm final
-    : public proxy {
+    : public proxy_base<shm> {
 public:
     /** \brief wl_interface for @ref shm */
     static const wl_interface interface;
@@ -138,6 +62,9 @@ public:
     /** \brief @ref shm version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref shm, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = -1;
+
     /** \brief Wrap existing wl_shm object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_shm object and is responsible for destryoing it
@@ -153,7 +80,7 @@ public:
     shm(shm&& rhs) = default;
 
     /** \brief Default destructor */
-    virtual ~shm() = default;
+    ~shm() = default;
 
     /** \brief Default move assignment operator */
     shm& operator=(shm&& rhs) = default;
@@ -186,7 +113,7 @@ public:
      */
     template <typename T>
     void set_format_handler(T&& handler) {
-        _format_handler = std::function<format_handler_sig>(std::forward<T>(handler));
+        _format_handler = delegate<format_handler_sig>(std::forward<T>(handler));
     }
 
 private:
@@ -198,7 +125,9 @@ private:
 
     static const listener_t listener;
 
-    std::function<format_handler_sig> _format_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<format_handler_sig> _format_handler;
 };
 
 } // namespace wlcpp
@@ -33,14 +33,20 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_shm_pool_request_create_buffer_types[] = { &buffer::interface, nullptr, nullptr, nullptr, nullptr, nullptr };
-static const wl_interface* wl_shm_pool_request_destroy_types[] = { };
-static const wl_interface* wl_shm_pool_request_resize_types[] = { nullptr };
+static const wl_interface* message_types[] = {
+    nullptr,
+    &buffer::interface,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+};
 
-static const wl_message wl_shm_pool_requests[] = {
-    { "create_buffer", "niiiiu", wl_shm_pool_request_create_buffer_types },
-    { "destroy", "", wl_shm_pool_request_destroy_types },
-    { "resize", "i", wl_shm_pool_request_resize_types },
+static constexpr wl_message wl_shm_pool_requests[] = {
+    { "create_buffer", "niiiiu", message_types + 1 },
+    { "destroy", "", message_types + 0 },
+    { "resize", "i", message_types + 0 },
 };
 
 const wl_interface shm_pool::interface = {
@@ -50,11 +56,11 @@ const wl_interface shm_pool::interface = {
 };
 
 shm_pool::shm_pool(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
+    : proxy_base<shm_pool>(obj, managed) {
 }
 
 shm_pool::shm_pool(proxy& factory)
-    : proxy(factory, interface) {
+    : proxy_base<shm_pool>(factory, interface) {
 }
 
 shm_pool::~shm_pool(){
@@ -62,18 +68,25 @@ shm_pool::~shm_pool(){
 }
 
 buffer shm_pool::create_buffer(int32_t offset_, int32_t width_, int32_t height_, int32_t stride_, uint32_t format_) {
-    buffer id_(*this);
-    marshal(0, id_.wl_obj(), offset_, width_, height_, stride_, format_);
-    return id_;
+    wl_argument args[6];
+    args[0].o = nullptr;
+    args[1].i = offset_;
+    args[2].i = width_;
+    args[3].i = height_;
+    args[4].i = stride_;
+    args[5].u = format_;
+    return wrap<buffer>(marshal_array_constructor(0, args, buffer::interface, interface.methods[0]));
 }
 
 void shm_pool::resize(int32_t size_) {
-    marshal(2, size_);
+    wl_argument args[1];
+    args[0].i = size_;
+    marshal_array(2, args, interface.methods[2]);
 }
 
 void shm_pool::destroy() {
     if(valid() && managed()) {
-        marshal(1);
+        marshal_array(1, nullptr, interface.methods[1]);
     }
     proxy::destroy();
 }
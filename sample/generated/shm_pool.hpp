@@ -3,9 +3,14 @@
 #define _SHM_POOL_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,9 +42,6 @@
 
 namespace wlcpp {
 
-class buffer;
-
-#define WLCPP_SHM_POOL_VERSION 1
 
 /** \brief a shared memory pool
  *
@@ -51,7 +53,7 @@ class buffer;
  *  a surface or for many small buffers.
  */
 class shm_pool final
-    : public proxy {
+    : public proxy_base<shm_pool> {
 public:
     /** \brief wl_interface for @ref shm_pool */
     static const wl_interface interface;
@@ -59,6 +61,9 @@ public:
     /** \brief @ref shm_pool version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref shm_pool, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 1;
+
     /** \brief Wrap existing wl_shm_pool object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_shm_pool object and is responsible for destryoing it
@@ -74,7 +79,7 @@ public:
     shm_pool(shm_pool&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~shm_pool();
+    ~shm_pool();
 
     /** \brief Default move assignment operator */
     shm_pool& operator=(shm_pool&& rhs) = default;
@@ -111,8 +116,25 @@ public:
      */
     void resize(std::int32_t size_);
 
+    /** \brief Arguments of @ref resize, objects are passed as native objects */
+    struct resize_args {
+        static constexpr std::uint32_t opcode = 2;
+        static constexpr std::uint32_t arg_count = 1;
+
+        std::int32_t size_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].i = size_;
+        }
+    };
+
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<shm_pool>;
 };
 
 } // namespace wlcpp
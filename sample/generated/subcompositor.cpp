@@ -34,12 +34,16 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_subcompositor_request_destroy_types[] = { };
-static const wl_interface* wl_subcompositor_request_get_subsurface_types[] = { &subsurface::interface, &surface::interface, &surface::interface };
+static const wl_interface* message_types[] = {
+    nullptr,
+    &subsurface::interface,
+    &surface::interface,
+    &surface::interface,
+};
 
-static const wl_message wl_subcompositor_requests[] = {
-    { "destroy", "", wl_subcompositor_request_destroy_types },
-    { "get_subsurface", "noo", wl_subcompositor_request_get_subsurface_types },
+static constexpr wl_message wl_subcompositor_requests[] = {
+    { "destroy", "", message_types + 0 },
+    { "get_subsurface", "noo", message_types + 1 },
 };
 
 const wl_interface subcompositor::interface = {
@@ -49,11 +53,11 @@ const wl_interface subcompositor::interface = {
 };
 
 subcompositor::subcompositor(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
+    : proxy_base<subcompositor>(obj, managed) {
 }
 
 subcompositor::subcompositor(proxy& factory)
-    : proxy(factory, interface) {
+    : proxy_base<subcompositor>(factory, interface) {
 }
 
 subcompositor::~subcompositor(){
@@ -61,14 +65,16 @@ subcompositor::~subcompositor(){
 }
 
 subsurface subcompositor::get_subsurface(surface& surface_, surface& parent_) {
-    subsurface id_(*this);
-    marshal(1, id_.wl_obj(), surface_.wl_obj(), parent_.wl_obj());
-    return id_;
+    wl_argument args[3];
+    args[0].o = nullptr;
+    args[1].o = reinterpret_cast<wl_object*>(surface_.wl_obj());
+    args[2].o = reinterpret_cast<wl_object*>(parent_.wl_obj());
+    return wrap<subsurface>(marshal_array_constructor(1, args, subsurface::interface, interface.methods[1]));
 }
 
 void subcompositor::destroy() {
     if(valid() && managed()) {
-        marshal(0);
+        marshal_array(0, nullptr, interface.methods[0]);
     }
     proxy::destroy();
 }
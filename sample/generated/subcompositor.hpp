@@ -3,9 +3,14 @@
 #define _SUBCOMPOSITOR_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,16 +42,6 @@
 
 namespace wlcpp {
 
-class subsurface;
-class surface;
-
-#define WLCPP_SUBCOMPOSITOR_VERSION 1
-
-/**
- */
-enum subcompositor_error {
-    SUBCOMPOSITOR_ERROR_BAD_SURFACE = 0, /**< the to-be sub-surface is invalid */
-};
 
 /** \brief sub-surface compositing
  *
@@ -69,7 +64,7 @@ enum subcompositor_error {
  *  hardware when possible.
  */
 class subcompositor final
-    : public proxy {
+    : public proxy_base<subcompositor> {
 public:
     /** \brief wl_interface for @ref subcompositor */
     static const wl_interface interface;
@@ -77,6 +72,9 @@ public:
     /** \brief @ref subcompositor version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref subcompositor, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 0;
+
     /** \brief Wrap existing wl_subcompositor object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_subcompositor object and is responsible for destryoing it
@@ -92,7 +90,7 @@ public:
     subcompositor(subcompositor&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~subcompositor();
+    ~subcompositor();
 
     /** \brief Default move assignment operator */
     subcompositor& operator=(subcompositor&& rhs) = default;
@@ -113,7 +111,8 @@ public:
     subsurface get_subsurface(surface& surface_, surface& parent_);
 
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<subcompositor>;
 };
 
 } // namespace wlcpp
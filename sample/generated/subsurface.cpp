@@ -33,20 +33,19 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_subsurface_request_destroy_types[] = { };
-static const wl_interface* wl_subsurface_request_set_position_types[] = { nullptr, nullptr };
-static const wl_interface* wl_subsurface_request_place_above_types[] = { &surface::interface };
-static const wl_interface* wl_subsurface_request_place_below_types[] = { &surface::interface };
-static const wl_interface* wl_subsurface_request_set_sync_types[] = { };
-static const wl_interface* wl_subsurface_request_set_desync_types[] = { };
-
-static const wl_message wl_subsurface_requests[] = {
-    { "destroy", "", wl_subsurface_request_destroy_types },
-    { "set_position", "ii", wl_subsurface_request_set_position_types },
-    { "place_above", "o", wl_subsurface_request_place_above_types },
-    { "place_below", "o", wl_subsurface_request_place_below_types },
-    { "set_sync", "", wl_subsurface_request_set_sync_types },
-    { "set_desync", "", wl_subsurface_request_set_desync_types },
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    &surface::interface,
+};
+
+static constexpr wl_message wl_subsurface_requests[] = {
+    { "destroy", "", message_types + 0 },
+    { "set_position", "ii", message_types + 0 },
+    { "place_above", "o", message_types + 2 },
+    { "place_below", "o", message_types + 2 },
+    { "set_sync", "", message_types + 0 },
+    { "set_desync", "", message_types + 0 },
 };
 
 const wl_interface subsurface::interface = {
@@ -56,11 +55,11 @@ const wl_interface subsurface::interface = {
 };
 
 subsurface::subsurface(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
+    : proxy_base<subsurface>(obj, managed) {
 }
 
 subsurface::subsurface(proxy& factory)
-    : proxy(factory, interface) {
+    : proxy_base<subsurface>(factory, interface) {
 }
 
 subsurface::~subsurface(){
@@ -68,28 +67,35 @@ subsurface::~subsurface(){
 }
 
 void subsurface::set_position(int32_t x_, int32_t y_) {
-    marshal(1, x_, y_);
+    wl_argument args[2];
+    args[0].i = x_;
+    args[1].i = y_;
+    marshal_array(1, args, interface.methods[1]);
 }
 
 void subsurface::place_above(surface& sibling_) {
-    marshal(2, sibling_.wl_obj());
+    wl_argument args[1];
+    args[0].o = reinterpret_cast<wl_object*>(sibling_.wl_obj());
+    marshal_array(2, args, interface.methods[2]);
 }
 
 void subsurface::place_below(surface& sibling_) {
-    marshal(3, sibling_.wl_obj());
+    wl_argument args[1];
+    args[0].o = reinterpret_cast<wl_object*>(sibling_.wl_obj());
+    marshal_array(3, args, interface.methods[3]);
 }
 
 void subsurface::set_sync() {
-    marshal(4);
+    marshal_array(4, nullptr, interface.methods[4]);
 }
 
 void subsurface::set_desync() {
-    marshal(5);
+    marshal_array(5, nullptr, interface.methods[5]);
 }
 
 void subsurface::destroy() {
     if(valid() && managed()) {
-        marshal(0);
+        marshal_array(0, nullptr, interface.methods[0]);
     }
     proxy::destroy();
 }
@@ -3,9 +3,14 @@
 #define _SUBSURFACE_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,15 +42,6 @@
 
 namespace wlcpp {
 
-class surface;
-
-#define WLCPP_SUBSURFACE_VERSION 1
-
-/**
- */
-enum subsurface_error {
-    SUBSURFACE_ERROR_BAD_SURFACE = 0, /**< wl_surface is not a sibling or the parent */
-};
 
 /** \brief sub-surface interface to a wl_surface
  *
@@ -96,7 +92,7 @@ enum subsurface_error {
  *  If the parent wl_surface object is destroyed, the sub-surface is unmapped.
  */
 class subsurface final
-    : public proxy {
+    : public proxy_base<subsurface> {
 public:
     /** \brief wl_interface for @ref subsurface */
     static const wl_interface interface;
@@ -104,6 +100,9 @@ public:
     /** \brief @ref subsurface version at wrapper generation time */
     static constexpr std::uint32_t version = 1;
 
+    /** \brief Opcode of the destructor request of @ref subsurface, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 0;
+
     /** \brief Wrap existing wl_subsurface object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_subsurface object and is responsible for destryoing it
@@ -119,7 +118,7 @@ public:
     subsurface(subsurface&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~subsurface();
+    ~subsurface();
 
     /** \brief Default move assignment operator */
     subsurface& operator=(subsurface&& rhs) = default;
@@ -145,6 +144,24 @@ public:
      */
     void set_position(std::int32_t x_, std::int32_t y_);
 
+    /** \brief Arguments of @ref set_position, objects are passed as native objects */
+    struct set_position_args {
+        static constexpr std::uint32_t opcode = 1;
+        static constexpr std::uint32_t arg_count = 2;
+
+        std::int32_t x_;
+        std::int32_t y_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].i = x_;
+            args[1].i = y_;
+        }
+    };
+
     /** \brief restack the sub-surface
      *
      *  This sub-surface is taken from the stack, and put back just above the
@@ -164,6 +181,22 @@ public:
      */
     void place_above(surface& sibling_);
 
+    /** \brief Arguments of @ref place_above, objects are passed as native objects */
+    struct place_above_args {
+        static constexpr std::uint32_t opcode = 2;
+        static constexpr std::uint32_t arg_count = 1;
+
+        wl_proxy* sibling_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(sibling_);
+        }
+    };
+
     /** \brief restack the sub-surface
      *
      *  The sub-surface is placed just below of the reference surface. See
@@ -173,6 +206,22 @@ public:
      */
     void place_below(surface& sibling_);
 
+    /** \brief Arguments of @ref place_below, objects are passed as native objects */
+    struct place_below_args {
+        static constexpr std::uint32_t opcode = 3;
+        static constexpr std::uint32_t arg_count = 1;
+
+        wl_proxy* sibling_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(sibling_);
+        }
+    };
+
     /** \brief set sub-surface to synchronized mode
      *
      *  Change the commit behaviour of the sub-surface to synchronized mode, also
@@ -190,6 +239,19 @@ public:
      */
     void set_sync();
 
+    /** \brief Arguments of @ref set_sync, objects are passed as native objects */
+    struct set_sync_args {
+        static constexpr std::uint32_t opcode = 4;
+        static constexpr std::uint32_t arg_count = 0;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument*) const {
+        }
+    };
+
     /** \brief set sub-surface to desynchronized mode
      *
      *  Change the commit behaviour of the sub-surface to desynchronized mode, also
@@ -213,8 +275,22 @@ public:
      */
     void set_desync();
 
+    /** \brief Arguments of @ref set_desync, objects are passed as native objects */
+    struct set_desync_args {
+        static constexpr std::uint32_t opcode = 5;
+        static constexpr std::uint32_t arg_count = 0;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument*) const {
+        }
+    };
+
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<subsurface>;
 };
 
 } // namespace wlcpp
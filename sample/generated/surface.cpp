@@ -36,34 +36,34 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_surface_request_destroy_types[] = { };
-static const wl_interface* wl_surface_request_attach_types[] = { &buffer::interface, nullptr, nullptr };
-static const wl_interface* wl_surface_request_damage_types[] = { nullptr, nullptr, nullptr, nullptr };
-static const wl_interface* wl_surface_request_frame_types[] = { &callback::interface };
-static const wl_interface* wl_surface_request_set_opaque_region_types[] = { &region::interface };
-static const wl_interface* wl_surface_request_set_input_region_types[] = { &region::interface };
-static const wl_interface* wl_surface_request_commit_types[] = { };
-static const wl_interface* wl_surface_request_set_buffer_transform_types[] = { nullptr };
-static const wl_interface* wl_surface_request_set_buffer_scale_types[] = { nullptr };
-
-static const wl_message wl_surface_requests[] = {
-    { "destroy", "", wl_surface_request_destroy_types },
-    { "attach", "?oii", wl_surface_request_attach_types },
-    { "damage", "iiii", wl_surface_request_damage_types },
-    { "frame", "n", wl_surface_request_frame_types },
-    { "set_opaque_region", "?o", wl_surface_request_set_opaque_region_types },
-    { "set_input_region", "?o", wl_surface_request_set_input_region_types },
-    { "commit", "", wl_surface_request_commit_types },
-    { "set_buffer_transform", "2i", wl_surface_request_set_buffer_transform_types },
-    { "set_buffer_scale", "3i", wl_surface_request_set_buffer_scale_types },
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    &buffer::interface,
+    nullptr,
+    nullptr,
+    &callback::interface,
+    &region::interface,
+    &output::interface,
 };
 
-static const wl_interface* wl_surface_event_enter_types[] = { &output::interface };
-static const wl_interface* wl_surface_event_leave_types[] = { &output::interface };
+static constexpr wl_message wl_surface_requests[] = {
+    { "destroy", "", message_types + 0 },
+    { "attach", "?oii", message_types + 4 },
+    { "damage", "iiii", message_types + 0 },
+    { "frame", "n", message_types + 7 },
+    { "set_opaque_region", "?o", message_types + 8 },
+    { "set_input_region", "?o", message_types + 8 },
+    { "commit", "", message_types + 0 },
+    { "set_buffer_transform", "2i", message_types + 0 },
+    { "set_buffer_scale", "3i", message_types + 0 },
+};
 
-static const wl_message wl_surface_events[] = {
-    { "enter", "o", wl_surface_event_enter_types },
-    { "leave", "o", wl_surface_event_leave_types },
+static constexpr wl_message wl_surface_events[] = {
+    { "enter", "o", message_types + 9 },
+    { "leave", "o", message_types + 9 },
 };
 
 const wl_interface surface::interface = {
@@ -77,14 +77,28 @@ const surface::listener_t surface::listener = {
     &leave_handler,
 };
 
+int surface::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        enter_handler(data, wl_obj, reinterpret_cast<wl_proxy*>(args[0].o));
+        break;
+    case 1:
+        leave_handler(data, wl_obj, reinterpret_cast<wl_proxy*>(args[0].o));
+        break;
+    }
+    return 0;
+}
+
 surface::surface(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<surface>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 surface::surface(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<surface>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 surface::~surface(){
@@ -92,42 +106,59 @@ surface::~surface(){
 }
 
 void surface::attach(buffer* buffer_, int32_t x_, int32_t y_) {
-    marshal(1, buffer_ ? buffer_->wl_obj() : nullptr, x_, y_);
+    wl_argument args[3];
+    args[0].o = buffer_ ? reinterpret_cast<wl_object*>(buffer_->wl_obj()) : nullptr;
+    args[1].i = x_;
+    args[2].i = y_;
+    marshal_array(1, args, interface.methods[1]);
 }
 
 void surface::damage(int32_t x_, int32_t y_, int32_t width_, int32_t height_) {
-    marshal(2, x_, y_, width_, height_);
+    wl_argument args[4];
+    args[0].i = x_;
+    args[1].i = y_;
+    args[2].i = width_;
+    args[3].i = height_;
+    marshal_array(2, args, interface.methods[2]);
 }
 
 callback surface::frame() {
-    callback callback_(*this);
-    marshal(3, callback_.wl_obj());
-    return callback_;
+    wl_argument args[1];
+    args[0].o = nullptr;
+    return wrap<callback>(marshal_array_constructor(3, args, callback::interface, interface.methods[3]));
 }
 
 void surface::set_opaque_region(region* region_) {
-    marshal(4, region_ ? region_->wl_obj() : nullptr);
+    wl_argument args[1];
+    args[0].o = region_ ? reinterpret_cast<wl_object*>(region_->wl_obj()) : nullptr;
+    marshal_array(4, args, interface.methods[4]);
 }
 
 void surface::set_input_region(region* region_) {
-    marshal(5, region_ ? region_->wl_obj() : nullptr);
+    wl_argument args[1];
+    args[0].o = region_ ? reinterpret_cast<wl_object*>(region_->wl_obj()) : nullptr;
+    marshal_array(5, args, interface.methods[5]);
 }
 
 void surface::commit() {
-    marshal(6);
+    marshal_array(6, nullptr, interface.methods[6]);
 }
 
 void surface::set_buffer_transform(int32_t transform_) {
-    marshal(7, transform_);
+    wl_argument args[1];
+    args[0].i = transform_;
+    marshal_array(7, args, interface.methods[7]);
 }
 
 void surface::set_buffer_scale(int32_t scale_) {
-    marshal(8, scale_);
+    wl_argument args[1];
+    args[0].i = scale_;
+    marshal_array(8, args, interface.methods[8]);
 }
 
 void surface::destroy() {
     if(valid() && managed()) {
-        marshal(0);
+        marshal_array(0, nullptr, interface.methods[0]);
     }
     proxy::destroy();
 }
@@ -135,14 +166,14 @@ void surface::destroy() {
 void surface::enter_handler(void* data, wl_proxy* wl_obj, wl_proxy* output_) {
     auto& handler = proxy::user_data_to_wrapper_cast<surface>(data)->_enter_handler;
     if(handler) {
-        handler(*proxy::wrapper_cast<output>(output_));
+        handler(*proxy::wrapper_cast<output>(data, output_));
     }
 }
 
 void surface::leave_handler(void* data, wl_proxy* wl_obj, wl_proxy* output_) {
     auto& handler = proxy::user_data_to_wrapper_cast<surface>(data)->_leave_handler;
     if(handler) {
-        handler(*proxy::wrapper_cast<output>(output_));
+        handler(*proxy::wrapper_cast<output>(data, output_));
     }
 }
 
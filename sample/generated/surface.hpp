@@ -3,9 +3,14 @@
 #define _SURFACE_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,12 +42,6 @@
 
 namespace wlcpp {
 
-class buffer;
-class callback;
-class output;
-class region;
-
-#define WLCPP_SURFACE_VERSION 3
 
 /** \brief an onscreen surface
  *
@@ -57,7 +56,7 @@ class region;
  *  pointers, drag icons, etc.
  */
 class surface final
-    : public proxy {
+    : public proxy_base<surface> {
 public:
     /** \brief wl_interface for @ref surface */
     static const wl_interface interface;
@@ -65,6 +64,9 @@ public:
     /** \brief @ref surface version at wrapper generation time */
     static constexpr std::uint32_t version = 3;
 
+    /** \brief Opcode of the destructor request of @ref surface, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 0;
+
     /** \brief Wrap existing wl_surface object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_surface object and is responsible for destryoing it
@@ -80,7 +82,7 @@ public:
     surface(surface&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~surface();
+    ~surface();
 
     /** \brief Default move assignment operator */
     surface& operator=(surface&& rhs) = default;
@@ -129,6 +131,26 @@ public:
      */
     void attach(buffer* buffer_, std::int32_t x_, std::int32_t y_);
 
+    /** \brief Arguments of @ref attach, objects are passed as native objects */
+    struct attach_args {
+        static constexpr std::uint32_t opcode = 1;
+        static constexpr std::uint32_t arg_count = 3;
+
+        wl_proxy* buffer_;
+        std::int32_t x_;
+        std::int32_t y_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(buffer_);
+            args[1].i = x_;
+            args[2].i = y_;
+        }
+    };
+
     /** \brief mark part of the surface damaged
      *
      *  This request is used to describe the regions where the pending buffer is
@@ -156,6 +178,28 @@ public:
      */
     void damage(std::int32_t x_, std::int32_t y_, std::int32_t width_, std::int32_t height_);
 
+    /** \brief Arguments of @ref damage, objects are passed as native objects */
+    struct damage_args {
+        static constexpr std::uint32_t opcode = 2;
+        static constexpr std::uint32_t arg_count = 4;
+
+        std::int32_t x_;
+        std::int32_t y_;
+        std::int32_t width_;
+        std::int32_t height_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].i = x_;
+            args[1].i = y_;
+            args[2].i = width_;
+            args[3].i = height_;
+        }
+    };
+
     /** \brief request repaint feedback
      *
      *  Request notification when the next frame is displayed. Useful for throttling
@@ -209,6 +253,22 @@ public:
      */
     void set_opaque_region(region* region_);
 
+    /** \brief Arguments of @ref set_opaque_region, objects are passed as native objects */
+    struct set_opaque_region_args {
+        static constexpr std::uint32_t opcode = 4;
+        static constexpr std::uint32_t arg_count = 1;
+
+        wl_proxy* region_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(region_);
+        }
+    };
+
     /** \brief set input region
      *
      *  This request sets the region of the surface that can receive pointer and
@@ -237,6 +297,22 @@ public:
      */
     void set_input_region(region* region_);
 
+    /** \brief Arguments of @ref set_input_region, objects are passed as native objects */
+    struct set_input_region_args {
+        static constexpr std::uint32_t opcode = 5;
+        static constexpr std::uint32_t arg_count = 1;
+
+        wl_proxy* region_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].o = reinterpret_cast<wl_object*>(region_);
+        }
+    };
+
     /** \brief commit pending surface state
      *
      *  Surface state (input, opaque, and damage regions, attached buffers, etc.) is
@@ -258,6 +334,19 @@ public:
      */
     void commit();
 
+    /** \brief Arguments of @ref commit, objects are passed as native objects */
+    struct commit_args {
+        static constexpr std::uint32_t opcode = 6;
+        static constexpr std::uint32_t arg_count = 0;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument*) const {
+        }
+    };
+
     /** \brief sets the buffer transformation
      *
      *  This request sets an optional transformation on how the compositor
@@ -284,6 +373,22 @@ public:
      */
     void set_buffer_transform(std::int32_t transform_);
 
+    /** \brief Arguments of @ref set_buffer_transform, objects are passed as native objects */
+    struct set_buffer_transform_args {
+        static constexpr std::uint32_t opcode = 7;
+        static constexpr std::uint32_t arg_count = 1;
+
+        std::int32_t transform_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].i = transform_;
+        }
+    };
+
     /** \brief sets the buffer scaling factor
      *
      *  This request sets an optional scaling factor on how the compositor
@@ -307,6 +412,22 @@ public:
      */
     void set_buffer_scale(std::int32_t scale_);
 
+    /** \brief Arguments of @ref set_buffer_scale, objects are passed as native objects */
+    struct set_buffer_scale_args {
+        static constexpr std::uint32_t opcode = 8;
+        static constexpr std::uint32_t arg_count = 1;
+
+        std::int32_t scale_;
+
+        static const wl_message& message() {
+            return interface.methods[opcode];
+        }
+
+        void pack(wl_argument* args) const {
+            args[0].i = scale_;
+        }
+    };
+
     /** \brief surface enters an output
      *
      *  This is emitted whenever a surface's creation, movement, or resizing results
@@ -323,7 +444,7 @@ public:
      */
     template <typename T>
     void set_enter_handler(T&& handler) {
-        _enter_handler = std::function<enter_handler_sig>(std::forward<T>(handler));
+        _enter_handler = delegate<enter_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief surface leaves an output
@@ -341,11 +462,12 @@ public:
      */
     template <typename T>
     void set_leave_handler(T&& handler) {
-        _leave_handler = std::function<leave_handler_sig>(std::forward<T>(handler));
+        _leave_handler = delegate<leave_handler_sig>(std::forward<T>(handler));
     }
 
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<surface>;
 
 private:
     struct listener_t {
@@ -358,8 +480,10 @@ private:
 
     static const listener_t listener;
 
-    std::function<enter_handler_sig> _enter_handler;
-    std::function<leave_handler_sig> _leave_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<enter_handler_sig> _enter_handler;
+    delegate<leave_handler_sig> _leave_handler;
 };
 
 } // namespace wlcpp
@@ -33,24 +33,29 @@ using namespace wlcpp;
  * THIS SOFTWARE.
  */
 
-static const wl_interface* wl_touch_request_release_types[] = { };
+static const wl_interface* message_types[] = {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    &surface::interface,
+    nullptr,
+    nullptr,
+    nullptr,
+};
 
-static const wl_message wl_touch_requests[] = {
-    { "release", "3", wl_touch_request_release_types },
+static constexpr wl_message wl_touch_requests[] = {
+    { "release", "3", message_types + 0 },
 };
 
-static const wl_interface* wl_touch_event_down_types[] = { nullptr, nullptr, &surface::interface, nullptr, nullptr, nullptr };
-static const wl_interface* wl_touch_event_up_types[] = { nullptr, nullptr, nullptr };
-static const wl_interface* wl_touch_event_motion_types[] = { nullptr, nullptr, nullptr, nullptr };
-static const wl_interface* wl_touch_event_frame_types[] = { };
-static const wl_interface* wl_touch_event_cancel_types[] = { };
-
-static const wl_message wl_touch_events[] = {
-    { "down", "uuoiff", wl_touch_event_down_types },
-    { "up", "uui", wl_touch_event_up_types },
-    { "motion", "uiff", wl_touch_event_motion_types },
-    { "frame", "", wl_touch_event_frame_types },
-    { "cancel", "", wl_touch_event_cancel_types },
+static constexpr wl_message wl_touch_events[] = {
+    { "down", "uuoiff", message_types + 4 },
+    { "up", "uui", message_types + 0 },
+    { "motion", "uiff", message_types + 0 },
+    { "frame", "", message_types + 0 },
+    { "cancel", "", message_types + 0 },
 };
 
 const wl_interface touch::interface = {
@@ -67,14 +72,37 @@ const touch::listener_t touch::listener = {
     &cancel_handler,
 };
 
+int touch::dispatcher(const void* implementation, void* target, uint32_t opcode, const wl_message* message, wl_argument* args) {
+    wl_proxy* wl_obj = static_cast<wl_proxy*>(target);
+    void* data = wl_proxy_get_user_data(wl_obj);
+    switch(opcode) {
+    case 0:
+        down_handler(data, wl_obj, args[0].u, args[1].u, reinterpret_cast<wl_proxy*>(args[2].o), args[3].i, args[4].f, args[5].f);
+        break;
+    case 1:
+        up_handler(data, wl_obj, args[0].u, args[1].u, args[2].i);
+        break;
+    case 2:
+        motion_handler(data, wl_obj, args[0].u, args[1].i, args[2].f, args[3].f);
+        break;
+    case 3:
+        frame_handler(data, wl_obj);
+        break;
+    case 4:
+        cancel_handler(data, wl_obj);
+        break;
+    }
+    return 0;
+}
+
 touch::touch(wl_proxy* obj, bool managed)
-    : proxy(obj, managed) {
-    add_listener(listener);
+    : proxy_base<touch>(obj, managed) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 touch::touch(proxy& factory)
-    : proxy(factory, interface) {
-    add_listener(listener);
+    : proxy_base<touch>(factory, interface) {
+    add_dispatcher(&dispatcher, listener);
 }
 
 touch::~touch(){
@@ -83,7 +111,7 @@ touch::~touch(){
 
 void touch::destroy() {
     if(valid() && managed()) {
-        marshal(0);
+        marshal_array(0, nullptr, interface.methods[0]);
     }
     proxy::destroy();
 }
@@ -91,7 +119,7 @@ void touch::destroy() {
 void touch::down_handler(void* data, wl_proxy* wl_obj, uint32_t serial_, uint32_t time_, wl_proxy* surface_, int32_t id_, wl_fixed_t x_, wl_fixed_t y_) {
     auto& handler = proxy::user_data_to_wrapper_cast<touch>(data)->_down_handler;
     if(handler) {
-        handler(serial_, time_, *proxy::wrapper_cast<surface>(surface_), id_, x_, y_);
+        handler(serial_, time_, *proxy::wrapper_cast<surface>(data, surface_), id_, x_, y_);
     }
 }
 
@@ -3,9 +3,14 @@
 #define _TOUCH_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include "../array_view.hpp"
+#include "../delegate.hpp"
 #include "../proxy.hpp"
+#include "../string_ref.hpp"
+#include "wayland_fwd.hpp"
 
 /* The following code was generated from the "wayland" protocol specification.
  *
@@ -37,9 +42,6 @@
 
 namespace wlcpp {
 
-class surface;
-
-#define WLCPP_TOUCH_VERSION 3
 
 /** \brief touchscreen input device
  *
@@ -51,7 +53,7 @@ class surface;
  *  same contact point can be identified by the ID of the sequence.
  */
 class touch final
-    : public proxy {
+    : public proxy_base<touch> {
 public:
     /** \brief wl_interface for @ref touch */
     static const wl_interface interface;
@@ -59,6 +61,9 @@ public:
     /** \brief @ref touch version at wrapper generation time */
     static constexpr std::uint32_t version = 3;
 
+    /** \brief Opcode of the destructor request of @ref touch, -1 if there is none */
+    static constexpr std::int32_t destructor_opcode = 0;
+
     /** \brief Wrap existing wl_touch object
      *  @param obj Existing native object to wrap, can be nullptr
      *  @param managed true, if the new wrapper object owns the wl_touch object and is responsible for destryoing it
@@ -74,7 +79,7 @@ public:
     touch(touch&& rhs) = default;
 
     /** \brief Destructor */
-    virtual ~touch();
+    ~touch();
 
     /** \brief Default move assignment operator */
     touch& operator=(touch&& rhs) = default;
@@ -99,7 +104,7 @@ public:
      */
     template <typename T>
     void set_down_handler(T&& handler) {
-        _down_handler = std::function<down_handler_sig>(std::forward<T>(handler));
+        _down_handler = delegate<down_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief end of a touch event sequence
@@ -119,7 +124,7 @@ public:
      */
     template <typename T>
     void set_up_handler(T&& handler) {
-        _up_handler = std::function<up_handler_sig>(std::forward<T>(handler));
+        _up_handler = delegate<up_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief update of touch point coordinates
@@ -138,7 +143,7 @@ public:
      */
     template <typename T>
     void set_motion_handler(T&& handler) {
-        _motion_handler = std::function<motion_handler_sig>(std::forward<T>(handler));
+        _motion_handler = delegate<motion_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief end of touch frame event
@@ -152,7 +157,7 @@ public:
      */
     template <typename T>
     void set_frame_handler(T&& handler) {
-        _frame_handler = std::function<frame_handler_sig>(std::forward<T>(handler));
+        _frame_handler = delegate<frame_handler_sig>(std::forward<T>(handler));
     }
 
     /** \brief touch session cancelled
@@ -170,11 +175,12 @@ public:
      */
     template <typename T>
     void set_cancel_handler(T&& handler) {
-        _cancel_handler = std::function<cancel_handler_sig>(std::forward<T>(handler));
+        _cancel_handler = delegate<cancel_handler_sig>(std::forward<T>(handler));
     }
 
 protected:
-    void destroy() override;
+    void destroy();
+    friend class proxy_base<touch>;
 
 private:
     struct listener_t {
@@ -193,11 +199,13 @@ private:
 
     static const listener_t listener;
 
-    std::function<down_handler_sig> _down_handler;
-    std::function<up_handler_sig> _up_handler;
-    std::function<motion_handler_sig> _motion_handler;
-    std::function<frame_handler_sig> _frame_handler;
-    std::function<cancel_handler_sig> _cancel_handler;
+    static int dispatcher(const void* implementation, void* target, std::uint32_t opcode, const wl_message* message, wl_argument* args);
+
+    delegate<down_handler_sig> _down_handler;
+    delegate<up_handler_sig> _up_handler;
+    delegate<motion_handler_sig> _motion_handler;
+    delegate<frame_handler_sig> _frame_handler;
+    delegate<cancel_handler_sig> _cancel_handler;
 };
 
 } // namespace wlcpp
@@ -0,0 +1,340 @@
+
+#ifndef _WAYLAND_FWD_HPP_
+#define _WAYLAND_FWD_HPP_
+
+/* The following code was generated from the "wayland" protocol specification.
+ *
+ * Copyright © 2008-2011 Kristian Høgsberg
+ * Copyright © 2010-2011 Intel Corporation
+ * Copyright © 2012-2013 Collabora, Ltd.
+ *
+ * Permission to use, copy, modify, distribute, and sell this
+ * software and its documentation for any purpose is hereby granted
+ * without fee, provided that the above copyright notice appear in
+ * all copies and that both that copyright notice and this permission
+ * notice appear in supporting documentation, and that the name of
+ * the copyright holders not be used in advertising or publicity
+ * pertaining to distribution of the software without specific,
+ * written prior permission.  The copyright holders make no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE COPYRIGHT HOLDERS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS
+ * SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS, IN NO EVENT SHALL THE COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF
+ * THIS SOFTWARE.
+ */
+
+namespace wlcpp {
+
+class display;
+class registry;
+class callback;
+class compositor;
+class shm_pool;
+class shm;
+class buffer;
+class data_offer;
+class data_source;
+class data_device;
+class data_device_manager;
+class shell;
+class shell_surface;
+class surface;
+class seat;
+class pointer;
+class keyboard;
+class touch;
+class output;
+class region;
+class subcompositor;
+class subsurface;
+
+#define WLCPP_DISPLAY_VERSION 1
+
+/** \brief global error values
+ *
+ *  These errors are global and can be emitted in response to any server
+ *  request.
+ */
+enum display_error {
+    DISPLAY_ERROR_INVALID_OBJECT = 0, /**< server couldn't find object */
+    DISPLAY_ERROR_INVALID_METHOD = 1, /**< method doesn't exist on the specified interface */
+    DISPLAY_ERROR_NO_MEMORY = 2, /**< server is out of memory */
+};
+
+#define WLCPP_REGISTRY_VERSION 1
+
+#define WLCPP_CALLBACK_VERSION 1
+
+#define WLCPP_COMPOSITOR_VERSION 3
+
+#define WLCPP_SHM_POOL_VERSION 1
+
+#define WLCPP_SHM_VERSION 1
+
+/** \brief wl_shm error values
+ *
+ *  These errors can be emitted in response to wl_shm requests.
+ */
+enum shm_error {
+    SHM_ERROR_INVALID_FORMAT = 0, /**< buffer format is not known */
+    SHM_ERROR_INVALID_STRIDE = 1, /**< invalid size or stride during pool or buffer creation */
+    SHM_ERROR_INVALID_FD = 2, /**< mmapping the file descriptor failed */
+};
+
+/** \brief pixel formats
+ *
+ *  This describes the memory layout of an individual pixel.
+ *
+ *  All renderers should support argb8888 and xrgb8888 but any other formats are
+ *  optional and may not be supported by the particular renderer in use.
+ */
+enum shm_format {
+    SHM_FORMAT_ARGB8888 = 0, /**< 32-bit ARGB format */
+    SHM_FORMAT_XRGB8888 = 1, /**< 32-bit RGB format */
+    SHM_FORMAT_C8 = 0x20203843,
+    SHM_FORMAT_RGB332 = 0x38424752,
+    SHM_FORMAT_BGR233 = 0x38524742,
+    SHM_FORMAT_XRGB4444 = 0x32315258,
+    SHM_FORMAT_XBGR4444 = 0x32314258,
+    SHM_FORMAT_RGBX4444 = 0x32315852,
+    SHM_FORMAT_BGRX4444 = 0x32315842,
+    SHM_FORMAT_ARGB4444 = 0x32315241,
+    SHM_FORMAT_ABGR4444 = 0x32314241,
+    SHM_FORMAT_RGBA4444 = 0x32314152,
+    SHM_FORMAT_BGRA4444 = 0x32314142,
+    SHM_FORMAT_XRGB1555 = 0x35315258,
+    SHM_FORMAT_XBGR1555 = 0x35314258,
+    SHM_FORMAT_RGBX5551 = 0x35315852,
+    SHM_FORMAT_BGRX5551 = 0x35315842,
+    SHM_FORMAT_ARGB1555 = 0x35315241,
+    SHM_FORMAT_ABGR1555 = 0x35314241,
+    SHM_FORMAT_RGBA5551 = 0x35314152,
+    SHM_FORMAT_BGRA5551 = 0x35314142,
+    SHM_FORMAT_RGB565 = 0x36314752,
+    SHM_FORMAT_BGR565 = 0x36314742,
+    SHM_FORMAT_RGB888 = 0x34324752,
+    SHM_FORMAT_BGR888 = 0x34324742,
+    SHM_FORMAT_XBGR8888 = 0x34324258,
+    SHM_FORMAT_RGBX8888 = 0x34325852,
+    SHM_FORMAT_BGRX8888 = 0x34325842,
+    SHM_FORMAT_ABGR8888 = 0x34324241,
+    SHM_FORMAT_RGBA8888 = 0x34324152,
+    SHM_FORMAT_BGRA8888 = 0x34324142,
+    SHM_FORMAT_XRGB2101010 = 0x30335258,
+    SHM_FORMAT_XBGR2101010 = 0x30334258,
+    SHM_FORMAT_RGBX1010102 = 0x30335852,
+    SHM_FORMAT_BGRX1010102 = 0x30335842,
+    SHM_FORMAT_ARGB2101010 = 0x30335241,
+    SHM_FORMAT_ABGR2101010 = 0x30334241,
+    SHM_FORMAT_RGBA1010102 = 0x30334152,
+    SHM_FORMAT_BGRA1010102 = 0x30334142,
+    SHM_FORMAT_YUYV = 0x56595559,
+    SHM_FORMAT_YVYU = 0x55595659,
+    SHM_FORMAT_UYVY = 0x59565955,
+    SHM_FORMAT_VYUY = 0x59555956,
+    SHM_FORMAT_AYUV = 0x56555941,
+    SHM_FORMAT_NV12 = 0x3231564e,
+    SHM_FORMAT_NV21 = 0x3132564e,
+    SHM_FORMAT_NV16 = 0x3631564e,
+    SHM_FORMAT_NV61 = 0x3136564e,
+    SHM_FORMAT_YUV410 = 0x39565559,
+    SHM_FORMAT_YVU410 = 0x39555659,
+    SHM_FORMAT_YUV411 = 0x31315559,
+    SHM_FORMAT_YVU411 = 0x31315659,
+    SHM_FORMAT_YUV420 = 0x32315559,
+    SHM_FORMAT_YVU420 = 0x32315659,
+    SHM_FORMAT_YUV422 = 0x36315559,
+    SHM_FORMAT_YVU422 = 0x36315659,
+    SHM_FORMAT_YUV444 = 0x34325559,
+    SHM_FORMAT_YVU444 = 0x34325659,
+};
+
+#define WLCPP_BUFFER_VERSION 1
+
+#define WLCPP_DATA_OFFER_VERSION 1
+
+#define WLCPP_DATA_SOURCE_VERSION 1
+
+#define WLCPP_DATA_DEVICE_VERSION 1
+
+#define WLCPP_DATA_DEVICE_MANAGER_VERSION 1
+
+#define WLCPP_SHELL_VERSION 1
+
+#define WLCPP_SHELL_SURFACE_VERSION 1
+
+/** \brief edge values for resizing
+ *
+ *  These values are used to indicate which edge of a surface is being dragged
+ *  in a resize operation. The server may use this information to adapt its
+ *  behavior, e.g. choose an appropriate cursor image.
+ */
+enum shell_surface_resize {
+    SHELL_SURFACE_RESIZE_NONE = 0,
+    SHELL_SURFACE_RESIZE_TOP = 1,
+    SHELL_SURFACE_RESIZE_BOTTOM = 2,
+    SHELL_SURFACE_RESIZE_LEFT = 4,
+    SHELL_SURFACE_RESIZE_TOP_LEFT = 5,
+    SHELL_SURFACE_RESIZE_BOTTOM_LEFT = 6,
+    SHELL_SURFACE_RESIZE_RIGHT = 8,
+    SHELL_SURFACE_RESIZE_TOP_RIGHT = 9,
+    SHELL_SURFACE_RESIZE_BOTTOM_RIGHT = 10,
+};
+
+/** \brief details of transient behaviour
+ *
+ *  These flags specify details of the expected behaviour of transient surfaces.
+ *  Used in the set_transient request.
+ */
+enum shell_surface_transient {
+    SHELL_SURFACE_TRANSIENT_INACTIVE = 0x1, /**< do not set keyboard focus */
+};
+
+/** \brief different method to set the surface fullscreen
+ *
+ *  Hints to indicate to the compositor how to deal with a conflict between the
+ *  dimensions of the surface and the dimensions of the output. The compositor
+ *  is free to ignore this parameter.
+ */
+enum shell_surface_fullscreen_method {
+    SHELL_SURFACE_FULLSCREEN_METHOD_DEFAULT = 0, /**< no preference, apply default policy */
+    SHELL_SURFACE_FULLSCREEN_METHOD_SCALE = 1, /**< scale, preserve the surface's aspect ratio and center on output */
+    SHELL_SURFACE_FULLSCREEN_METHOD_DRIVER = 2, /**< switch output mode to the smallest mode that can fit the surface, add black borders to compensate size mismatch */
+    SHELL_SURFACE_FULLSCREEN_METHOD_FILL = 3, /**< no upscaling, center on output and add black borders to compensate size mismatch */
+};
+
+#define WLCPP_SURFACE_VERSION 3
+
+#define WLCPP_SEAT_VERSION 3
+
+/** \brief seat capability bitmask
+ *
+ *  This is a bitmask of capabilities this seat has; if a member is set, then it
+ *  is present on the seat.
+ */
+enum seat_capability {
+    SEAT_CAPABILITY_POINTER = 1, /**< The seat has pointer devices */
+    SEAT_CAPABILITY_KEYBOARD = 2, /**< The seat has one or more keyboards */
+    SEAT_CAPABILITY_TOUCH = 4, /**< The seat has touch devices */
+};
+
+#define WLCPP_POINTER_VERSION 3
+
+/** \brief physical button state
+ *
+ *  Describes the physical state of a button which provoked the button event.
+ */
+enum pointer_button_state {
+    POINTER_BUTTON_STATE_RELEASED = 0, /**< The button is not pressed */
+    POINTER_BUTTON_STATE_PRESSED = 1, /**< The button is pressed */
+};
+
+/** \brief axis types
+ *
+ *  Describes the axis types of scroll events.
+ */
+enum pointer_axis {
+    POINTER_AXIS_VERTICAL_SCROLL = 0,
+    POINTER_AXIS_HORIZONTAL_SCROLL = 1,
+};
+
+#define WLCPP_KEYBOARD_VERSION 3
+
+/** \brief keyboard mapping format
+ *
+ *  This specifies the format of the keymap provided to the client with the
+ *  wl_keyboard.keymap event.
+ */
+enum keyboard_keymap_format {
+    KEYBOARD_KEYMAP_FORMAT_NO_KEYMAP = 0, /**< no keymap; client must understand how to interpret the raw keycode */
+    KEYBOARD_KEYMAP_FORMAT_XKB_V1 = 1, /**< libxkbcommon compatible */
+};
+
+/** \brief physical key state
+ *
+ *  Describes the physical state of a key which provoked the key event.
+ */
+enum keyboard_key_state {
+    KEYBOARD_KEY_STATE_RELEASED = 0, /**< key is not pressed */
+    KEYBOARD_KEY_STATE_PRESSED = 1, /**< key is pressed */
+};
+
+#define WLCPP_TOUCH_VERSION 3
+
+#define WLCPP_OUTPUT_VERSION 2
+
+/** \brief subpixel geometry information
+ *
+ *  This enumeration describes how the physical pixels on an output are layed
+ *  out.
+ */
+enum output_subpixel {
+    OUTPUT_SUBPIXEL_UNKNOWN = 0,
+    OUTPUT_SUBPIXEL_NONE = 1,
+    OUTPUT_SUBPIXEL_HORIZONTAL_RGB = 2,
+    OUTPUT_SUBPIXEL_HORIZONTAL_BGR = 3,
+    OUTPUT_SUBPIXEL_VERTICAL_RGB = 4,
+    OUTPUT_SUBPIXEL_VERTICAL_BGR = 5,
+};
+
+/** \brief transform from framebuffer to output
+ *
+ *  This describes the transform that a compositor will apply to a surface to
+ *  compensate for the rotation or mirroring of an output device.
+ *
+ *  The flipped values correspond to an initial flip around a vertical axis
+ *  followed by rotation.
+ *
+ *  The purpose is mainly to allow clients render accordingly and tell the
+ *  compositor, so that for fullscreen surfaces, the compositor will still be
+ *  able to scan out directly from client surfaces.
+ */
+enum output_transform {
+    OUTPUT_TRANSFORM_NORMAL = 0,
+    OUTPUT_TRANSFORM_90 = 1,
+    OUTPUT_TRANSFORM_180 = 2,
+    OUTPUT_TRANSFORM_270 = 3,
+    OUTPUT_TRANSFORM_FLIPPED = 4,
+    OUTPUT_TRANSFORM_FLIPPED_90 = 5,
+    OUTPUT_TRANSFORM_FLIPPED_180 = 6,
+    OUTPUT_TRANSFORM_FLIPPED_270 = 7,
+};
+
+/** \brief mode information
+ *
+ *  These flags describe properties of an output mode. They are used in the
+ *  flags bitfield of the mode event.
+ */
+enum output_mode {
+    OUTPUT_MODE_CURRENT = 0x1, /**< indicates this is the current mode */
+    OUTPUT_MODE_PREFERRED = 0x2, /**< indicates this is the preferred mode */
+};
+
+#define WLCPP_REGION_VERSION 1
+
+#define WLCPP_SUBCOMPOSITOR_VERSION 1
+
+/**
+ */
+enum subcompositor_error {
+    SUBCOMPOSITOR_ERROR_BAD_SURFACE = 0, /**< the to-be sub-surface is invalid */
+};
+
+#define WLCPP_SUBSURFACE_VERSION 1
+
+/**
+ */
+enum subsurface_error {
+    SUBSURFACE_ERROR_BAD_SURFACE = 0, /**< wl_surface is not a sibling or the parent */
+};
+
+} // namespace wlcpp
+
+#endif // _WAYLAND_FWD_HPP_
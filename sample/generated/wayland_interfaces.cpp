@@ -0,0 +1,132 @@
+#include "wayland_interfaces.hpp"
+#include "registry.hpp"
+#include "callback.hpp"
+#include "compositor.hpp"
+#include "shm_pool.hpp"
+#include "shm.hpp"
+#include "buffer.hpp"
+#include "data_offer.hpp"
+#include "data_source.hpp"
+#include "data_device.hpp"
+#include "data_device_manager.hpp"
+#include "shell.hpp"
+#include "shell_surface.hpp"
+#include "surface.hpp"
+#include "seat.hpp"
+#include "pointer.hpp"
+#include "keyboard.hpp"
+#include "touch.hpp"
+#include "output.hpp"
+#include "region.hpp"
+#include "subcompositor.hpp"
+#include "subsurface.hpp"
+
+using namespace wlcpp;
+
+/* The following code was generated from the "wayland" protocol specification.
+ *
+ * Copyright © 2008-2011 Kristian Høgsberg
+ * Copyright © 2010-2011 Intel Corporation
+ * Copyright © 2012-2013 Collabora, Ltd.
+ *
+ * Permission to use, copy, modify, distribute, and sell this
+ * software and its documentation for any purpose is hereby granted
+ * without fee, provided that the above copyright notice appear in
+ * all copies and that both that copyright notice and this permission
+ * notice appear in supporting documentation, and that the name of
+ * the copyright holders not be used in advertising or publicity
+ * pertaining to distribution of the software without specific,
+ * written prior permission.  The copyright holders make no
+ * representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied
+ * warranty.
+ *
+ * THE COPYRIGHT HOLDERS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS
+ * SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS, IN NO EVENT SHALL THE COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN
+ * AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF
+ * THIS SOFTWARE.
+ */
+
+static const interface_info wayland_interface_table[64] = {
+    {},
+    {},
+    {},
+    {},
+    {},
+    { "wl_seat", 7, &seat::interface, seat::version, &interface_info::create_wrapper<seat>, &interface_info::destroy_wrapper<seat> },
+    { "wl_shell", 8, &shell::interface, shell::version, &interface_info::create_wrapper<shell>, &interface_info::destroy_wrapper<shell> },
+    { "wl_data_device_manager", 22, &data_device_manager::interface, data_device_manager::version, &interface_info::create_wrapper<data_device_manager>, &interface_info::destroy_wrapper<data_device_manager> },
+    {},
+    { "wl_data_offer", 13, &data_offer::interface, data_offer::version, &interface_info::create_wrapper<data_offer>, &interface_info::destroy_wrapper<data_offer> },
+    {},
+    { "wl_touch", 8, &touch::interface, touch::version, &interface_info::create_wrapper<touch>, &interface_info::destroy_wrapper<touch> },
+    {},
+    {},
+    { "wl_buffer", 9, &buffer::interface, buffer::version, &interface_info::create_wrapper<buffer>, &interface_info::destroy_wrapper<buffer> },
+    { "wl_surface", 10, &surface::interface, surface::version, &interface_info::create_wrapper<surface>, &interface_info::destroy_wrapper<surface> },
+    {},
+    { "wl_shm_pool", 11, &shm_pool::interface, shm_pool::version, &interface_info::create_wrapper<shm_pool>, &interface_info::destroy_wrapper<shm_pool> },
+    {},
+    {},
+    {},
+    { "wl_subsurface", 13, &subsurface::interface, subsurface::version, &interface_info::create_wrapper<subsurface>, &interface_info::destroy_wrapper<subsurface> },
+    { "wl_shell_surface", 16, &shell_surface::interface, shell_surface::version, &interface_info::create_wrapper<shell_surface>, &interface_info::destroy_wrapper<shell_surface> },
+    { "wl_data_device", 14, &data_device::interface, data_device::version, &interface_info::create_wrapper<data_device>, &interface_info::destroy_wrapper<data_device> },
+    {},
+    {},
+    {},
+    {},
+    {},
+    { "wl_pointer", 10, &pointer::interface, pointer::version, &interface_info::create_wrapper<pointer>, &interface_info::destroy_wrapper<pointer> },
+    {},
+    { "wl_callback", 11, &callback::interface, callback::version, &interface_info::create_wrapper<callback>, &interface_info::destroy_wrapper<callback> },
+    {},
+    {},
+    {},
+    { "wl_registry", 11, &registry::interface, registry::version, &interface_info::create_wrapper<registry>, &interface_info::destroy_wrapper<registry> },
+    { "wl_data_source", 14, &data_source::interface, data_source::version, &interface_info::create_wrapper<data_source>, &interface_info::destroy_wrapper<data_source> },
+    {},
+    {},
+    {},
+    {},
+    { "wl_keyboard", 11, &keyboard::interface, keyboard::version, &interface_info::create_wrapper<keyboard>, &interface_info::destroy_wrapper<keyboard> },
+    {},
+    {},
+    {},
+    {},
+    { "wl_shm", 6, &shm::interface, shm::version, &interface_info::create_wrapper<shm>, &interface_info::destroy_wrapper<shm> },
+    {},
+    {},
+    {},
+    {},
+    {},
+    {},
+    { "wl_compositor", 13, &compositor::interface, compositor::version, &interface_info::create_wrapper<compositor>, &interface_info::destroy_wrapper<compositor> },
+    {},
+    { "wl_subcompositor", 16, &subcompositor::interface, subcompositor::version, &interface_info::create_wrapper<subcompositor>, &interface_info::destroy_wrapper<subcompositor> },
+    { "wl_region", 9, &region::interface, region::version, &interface_info::create_wrapper<region>, &interface_info::destroy_wrapper<region> },
+    { "wl_output", 9, &output::interface, output::version, &interface_info::create_wrapper<output>, &interface_info::destroy_wrapper<output> },
+    {},
+    {},
+    {},
+    {},
+    {},
+    {},
+};
+
+const interface_info* wlcpp::find_wayland_interface(string_ref name) {
+    std::uint32_t hash = 0x811c9dd8;
+    for(std::size_t i = 0; i < name.size(); ++i) {
+        hash = (hash ^ static_cast<unsigned char>(name.data()[i])) * 16777619;
+    }
+
+    const interface_info& info = wayland_interface_table[hash & 63];
+    if(info.interface == nullptr || string_ref(info.name, info.name_size) != name) {
+        return nullptr;
+    }
+    return &info;
+}
@@ -0,0 +1,91 @@
+
+#include "global_manager.hpp"
+#include "generated/wayland_interfaces.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+constexpr uint32_t global_manager::max_indexed_name;
+
+global_manager::global_manager(display& d)
+    : _display(d),
+      _registry(d.get_registry()),
+      _ready(false) {
+    _registry.set_global_handler([this](uint32_t name, string_ref interface, uint32_t version) {
+        global(name, interface, version);
+    });
+    _registry.set_global_remove_handler([this](uint32_t name) {
+        global_remove(name);
+    });
+
+    // The globals are received before the first done. The objects bound for
+    // them send their initial events before the done of a sync which is sent
+    // after all binds.
+    _startup = sync_future(_display);
+    _startup.then([this](uint32_t) {
+        _startup = sync_future(_display);
+        _startup.then([this](uint32_t) {
+            _ready = true;
+            delegate<void ()> handler(move(_ready_handler));
+            if(handler) {
+                handler();
+            }
+        });
+    });
+}
+
+void global_manager::global(uint32_t name, string_ref interface, uint32_t version) {
+    // Interfaces of the core protocol are looked up once, so bindings are
+    // matched by their wl_interface. Names of other protocols are compared.
+    const interface_info* info = find_wayland_interface(interface);
+    for(auto& binding : _bindings) {
+        const wl_interface& i = binding->get_interface();
+        if(info != nullptr ? &i != info->interface : interface != i.name) {
+            continue;
+        }
+
+        // A binding rejects globals older than its min_version, which leaves
+        // them to later bindings of the same interface.
+        void* slot = binding->bind(_registry, name, version);
+        if(slot == nullptr) {
+            continue;
+        }
+
+        entry e = { binding.get(), slot };
+        if(name < max_indexed_name) {
+            if(name >= _entries.size()) {
+                _entries.resize(name + 1, entry{ nullptr, nullptr });
+            }
+            _entries[name] = e;
+        }
+        else {
+            _large_entries[name] = e;
+        }
+        return;
+    }
+}
+
+void global_manager::global_remove(uint32_t name) {
+    entry* e = find(name);
+    if(e == nullptr || e->binding == nullptr) {
+        return;
+    }
+
+    entry removed = *e;
+    if(name < max_indexed_name) {
+        *e = entry{ nullptr, nullptr };
+    }
+    else {
+        _large_entries.erase(name);
+    }
+    removed.binding->remove(removed.slot);
+}
+
+global_manager::entry* global_manager::find(uint32_t name) {
+    if(name < max_indexed_name) {
+        return name < _entries.size() ? &_entries[name] : nullptr;
+    }
+
+    auto it = _large_entries.find(name);
+    return it != _large_entries.end() ? &it->second : nullptr;
+}
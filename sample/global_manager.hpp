@@ -0,0 +1,239 @@
+
+#ifndef _WLCPP_GLOBAL_MANAGER_HPP_
+#define _WLCPP_GLOBAL_MANAGER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "delegate.hpp"
+#include "string_ref.hpp"
+#include "sync_future.hpp"
+#include "generated/display.hpp"
+#include "generated/registry.hpp"
+
+namespace wlcpp {
+
+class global_manager;
+
+class global_binding_base {
+public:
+    global_binding_base(const wl_interface& interface, std::uint32_t min_version, std::uint32_t max_version)
+        : _interface(interface),
+          _min_version(min_version),
+          _max_version(max_version) {
+    }
+
+    global_binding_base(const global_binding_base&) = delete;
+    virtual ~global_binding_base() = default;
+
+    global_binding_base& operator=(const global_binding_base&) = delete;
+
+    const wl_interface& get_interface() const {
+        return _interface;
+    }
+
+protected:
+    friend class global_manager;
+
+    /* Bind global name and return the slot which holds the object, or nullptr
+     * if the version of the global is too old. */
+    virtual void* bind(registry& r, std::uint32_t name, std::uint32_t version) = 0;
+    virtual void remove(void* slot) = 0;
+
+    std::uint32_t bind_version(std::uint32_t version) const {
+        return std::min(version, _max_version);
+    }
+
+    const wl_interface& _interface;
+    std::uint32_t _min_version;
+    std::uint32_t _max_version;
+};
+
+/* Objects bound by a global_manager for every global of interface T. */
+template <typename T>
+class global_binding : public global_binding_base {
+public:
+    /** \brief Called after global name has been bound to object */
+    using bind_handler_sig = void (std::uint32_t name, T& object);
+
+    /** \brief Called before the object of a removed global is destroyed */
+    using remove_handler_sig = void (std::uint32_t name, T& object);
+
+    global_binding(std::uint32_t min_version, std::uint32_t max_version)
+        : global_binding_base(T::interface, min_version, max_version < T::version ? max_version : T::version),
+          _count(0) {
+    }
+
+    template <typename F>
+    void set_bind_handler(F&& handler) {
+        _bind_handler = delegate<bind_handler_sig>(std::forward<F>(handler));
+    }
+
+    template <typename F>
+    void set_remove_handler(F&& handler) {
+        _remove_handler = delegate<remove_handler_sig>(std::forward<F>(handler));
+    }
+
+    /** \brief Number of bound objects */
+    std::size_t size() const {
+        return _count;
+    }
+
+    /** \brief First bound object, or nullptr, e.g. for singletons like compositor */
+    T* get() {
+        for(slot& s : _slots) {
+            if(s.object) {
+                return &s.object;
+            }
+        }
+        return nullptr;
+    }
+
+    /** \brief Call f(name, object) for every bound object */
+    template <typename F>
+    void for_each(F&& f) {
+        for(slot& s : _slots) {
+            if(s.object) {
+                f(s.name, s.object);
+            }
+        }
+    }
+
+protected:
+    void* bind(registry& r, std::uint32_t name, std::uint32_t version) override {
+        if(version < _min_version) {
+            return nullptr;
+        }
+
+        if(_free.empty()) {
+            _slots.emplace_back();
+            _free.push_back(&_slots.back());
+        }
+        slot* s = _free.back();
+        _free.pop_back();
+
+        s->name = name;
+        s->object = r.bind<T>(name, bind_version(version));
+        ++_count;
+        if(_bind_handler) {
+            _bind_handler(name, s->object);
+        }
+        return s;
+    }
+
+    void remove(void* ptr) override {
+        slot* s = static_cast<slot*>(ptr);
+        if(_remove_handler) {
+            _remove_handler(s->name, s->object);
+        }
+        s->object = T();
+        --_count;
+        _free.push_back(s);
+    }
+
+private:
+    struct slot {
+        T object;
+        std::uint32_t name;
+    };
+
+    // A deque keeps the objects in place, so their addresses stay valid
+    // until their global is removed.
+    std::deque<slot> _slots;
+    std::vector<slot*> _free;
+    std::size_t _count;
+    delegate<bind_handler_sig> _bind_handler;
+    delegate<remove_handler_sig> _remove_handler;
+};
+
+/* Binds the globals of a display which the application declared with want().
+ *
+ * Globals are bound in the global event itself, so all binds are sent within
+ * the initial burst of globals instead of after a roundtrip. The version is the
+ * one announced by the compositor, clamped to max_version and to the version
+ * of the generated class, and globals older than min_version are ignored.
+ * then() is called once the globals and the initial events of the objects
+ * bound for them were received. This takes two sequential round trips: the
+ * second sync is only sent from the done of the first one, after all globals
+ * were received and bound.
+ *
+ * The interface of a global is looked up once in the table generated by
+ * --interface-table, and bindings are compared by their wl_interface. Only
+ * interfaces of other protocols are compared by name.
+ *
+ * Objects are stored in slots indexed by the name of their global, so
+ * global_remove is handled without a search. Compositors based on
+ * libwayland-server allocate names densely, larger names are kept in a map.
+ */
+class global_manager {
+public:
+    explicit global_manager(display& d);
+    global_manager(const global_manager&) = delete;
+
+    global_manager& operator=(const global_manager&) = delete;
+
+    /** \brief Bind every global of interface T
+     *
+     *  If T is wanted more than once, a global is bound by the first binding
+     *  whose min_version it satisfies.
+     *  @param min_version Minimum version of the global
+     *  @param max_version Maximum version to bind, at most T::version
+     *  @return Objects which are bound for the interface
+     */
+    template <typename T>
+    global_binding<T>& want(std::uint32_t min_version = 1, std::uint32_t max_version = T::version) {
+        global_binding<T>* binding = new global_binding<T>(min_version, max_version);
+        _bindings.emplace_back(binding);
+        return *binding;
+    }
+
+    /** \brief Set the function which is called once the initial state was received */
+    template <typename F>
+    void then(F&& continuation) {
+        if(_ready) {
+            continuation();
+        }
+        else {
+            _ready_handler = delegate<void ()>(std::forward<F>(continuation));
+        }
+    }
+
+    /** \brief Whether the initial state was received */
+    bool ready() const {
+        return _ready;
+    }
+
+    registry& get_registry() {
+        return _registry;
+    }
+
+private:
+    struct entry {
+        global_binding_base* binding;
+        void* slot;
+    };
+
+    static constexpr std::uint32_t max_indexed_name = 0x10000;
+
+    void global(std::uint32_t name, string_ref interface, std::uint32_t version);
+    void global_remove(std::uint32_t name);
+    entry* find(std::uint32_t name);
+
+    display& _display;
+    registry _registry;
+    std::vector<std::unique_ptr<global_binding_base>> _bindings;
+    std::vector<entry> _entries;
+    std::unordered_map<std::uint32_t, entry> _large_entries;
+    sync_future _startup;
+    delegate<void ()> _ready_handler;
+    bool _ready;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_GLOBAL_MANAGER_HPP_
+
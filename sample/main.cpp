@@ -1,24 +1,19 @@
 
 #include <functional>
 #include <iostream>
-#include <map>
-#include <poll.h>
 #include "generated/compositor.hpp"
 #include "generated/display.hpp"
 #include "generated/output.hpp"
-#include "generated/registry.hpp"
 #include "generated/shm.hpp"
 #include "generated/seat.hpp"
+#include "event_loop.hpp"
+#include "global_manager.hpp"
+#include "request_batch.hpp"
 
 using namespace std;
 using namespace std::placeholders;
 
 wlcpp::display display;
-wlcpp::registry registry;
-wlcpp::compositor compositor;
-wlcpp::shm shm;
-map<uint32_t, wlcpp::seat> seats;
-map<uint32_t, wlcpp::output> outputs;
 
 static void shm_format_handler(uint32_t format) {
     cout << "shm::format(" << format << ")" << endl;
@@ -28,11 +23,11 @@ static void seat_capabilities_handler(uint32_t seat_name, uint32_t capabilities)
     cout << "seat::capabilities(" << seat_name << ", " << capabilities << ")" << endl;
 }
 
-static void seat_name_handler(uint32_t seat_name, const string& name) {
+static void seat_name_handler(uint32_t seat_name, wlcpp::string_ref name) {
     cout << "seat::name(" << seat_name << ", \"" << name << "\")" << endl;
 }
 
-static void output_geometry_handler(uint32_t output_name, int32_t x, int32_t y, int32_t physical_width, int32_t physical_height, int32_t subpixel, const string& make, const string& model, int32_t transform) {
+static void output_geometry_handler(uint32_t output_name, int32_t x, int32_t y, int32_t physical_width, int32_t physical_height, int32_t subpixel, wlcpp::string_ref make, wlcpp::string_ref model, int32_t transform) {
     cout << "output::geometry(" << output_name << ", " << x << ", " << y << ", " << physical_width << ", " << physical_height << ", " << subpixel << ", \"" << make << "\", \"" << model << "\", " << transform << ")" << endl;
 }
 
@@ -48,37 +43,24 @@ static void output_scale_handler(uint32_t output_name, int32_t factor) {
     cout << "output::scale(" << output_name << ", " << factor << ")" << endl;
 }
 
-static void registry_global_handler(uint32_t name, const string& interface, uint32_t version) {
-    cout << "registry::global(" << name << ", \"" << interface  << "\", " << version << ")" << endl;
+static void shm_bind_handler(uint32_t name, wlcpp::shm& shm) {
+    shm.set_format_handler(&shm_format_handler);
+}
 
-    if(!compositor && (interface == wlcpp::compositor::interface.name)) {
-        compositor = registry.bind<wlcpp::compositor>(name, version);
-    }
-    else if(!shm && (interface == wlcpp::shm::interface.name)) {
-        shm = registry.bind<wlcpp::shm>(name, version);
-        shm.set_format_handler(&shm_format_handler);
-    }
-    else if(interface == wlcpp::seat::interface.name) {
-        wlcpp::seat seat = registry.bind<wlcpp::seat>(name, version);
-        seat.set_name_handler(bind(&seat_name_handler, name, _1));
-        seat.set_capabilities_handler(bind(&seat_capabilities_handler, name, _1));
-        seats.emplace(name, move(seat));
-    }
-    else if(interface == wlcpp::output::interface.name) {
-        wlcpp::output output = registry.bind<wlcpp::output>(name, version);
-        output.set_geometry_handler(bind(&output_geometry_handler, name, _1, _2, _3, _4, _5, _6, _7, _8));
-        output.set_mode_handler(bind(&output_mode_handler, name, _1, _2, _3, _4));
-        output.set_done_handler(bind(&output_done_handler, name));
-        output.set_scale_handler(bind(output_scale_handler, name, _1));
-        outputs.emplace(name, move(output));
-    }
+static void seat_bind_handler(uint32_t name, wlcpp::seat& seat) {
+    seat.set_name_handler(bind(&seat_name_handler, name, _1));
+    seat.set_capabilities_handler(bind(&seat_capabilities_handler, name, _1));
 }
 
-static void registry_global_remove_handler(uint32_t name) {
-    cout << "registry::global_remove(" << name << ")" << endl;
+static void output_bind_handler(uint32_t name, wlcpp::output& output) {
+    output.set_geometry_handler(bind(&output_geometry_handler, name, _1, _2, _3, _4, _5, _6, _7, _8));
+    output.set_mode_handler(bind(&output_mode_handler, name, _1, _2, _3, _4));
+    output.set_done_handler(bind(&output_done_handler, name));
+    output.set_scale_handler(bind(output_scale_handler, name, _1));
+}
 
-    seats.erase(name);
-    outputs.erase(name);
+static void global_remove_handler(uint32_t name, wlcpp::proxy& object) {
+    cout << "registry::global_remove(" << name << ", \"" << object.get_class() << "\")" << endl;
 }
 
 int main(int argc, char* argv[]) {
@@ -88,39 +70,37 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    registry = display.get_registry();
-    registry.set_global_handler(&registry_global_handler);
-    registry.set_global_remove_handler(&registry_global_remove_handler);
-
-    pollfd pfd = {
-        display.get_fd(),
-        POLLIN | POLLOUT,
-        0
-    };
-
-    while(true) {
-        if(!(pfd.events & POLLOUT)) {
-            display.flush();
-        }
-
-        if(poll(&pfd, 1, 1000) > 0) {
-            if(pfd.revents & POLLIN) {
-                display.dispatch();
-            }
-
-            if(pfd.revents & POLLHUP) {
-                pfd.events = POLLIN | POLLOUT;
-            }
-
-            if(pfd.revents & POLLOUT) {
-                pfd.events = POLLIN;
-            }
-        }
-        else {
-            break;
-        }
+    // Requests are collected and flushed once per iteration of the event loop.
+    wlcpp::request_batch batch(display);
+
+    // Globals are bound as soon as they are announced. The manager is ready
+    // once the bound objects have sent their initial state.
+    wlcpp::global_manager globals(display);
+    globals.want<wlcpp::compositor>();
+    globals.want<wlcpp::shm>().set_bind_handler(&shm_bind_handler);
+
+    wlcpp::global_binding<wlcpp::seat>& seats = globals.want<wlcpp::seat>();
+    seats.set_bind_handler(&seat_bind_handler);
+    seats.set_remove_handler(&global_remove_handler);
+
+    wlcpp::global_binding<wlcpp::output>& outputs = globals.want<wlcpp::output>();
+    outputs.set_bind_handler(&output_bind_handler);
+    outputs.set_remove_handler(&global_remove_handler);
+
+    globals.then([&seats, &outputs]() {
+        cout << "initial state received: " << seats.size() << " seats, " << outputs.size() << " outputs" << endl;
+    });
+
+    wlcpp::event_loop loop(display);
+
+    // The loop flushes through the batch before it waits. The sample exits
+    // after it received no events for a second.
+    while(loop.dispatch(1000) > 0) {
     }
 
+    const wlcpp::flush_stats& stats = batch.stats();
+    cout << "flushes: " << stats.flushes << ", messages: " << stats.messages << ", bytes: " << stats.bytes << endl;
+
     return 0;
 }
 
@@ -0,0 +1,86 @@
+
+#ifndef _WLCPP_OBJECT_TABLE_HPP_
+#define _WLCPP_OBJECT_TABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace wlcpp {
+
+class proxy;
+
+/* Maps the object ids of one display to their wrappers. libwayland allocates
+ * the ids of objects created by the client densely from 1 and the ids of
+ * objects created by the server densely from 0xff000000, so both ranges are
+ * stored in vectors which are indexed by the id. Lookup is a bounds check and
+ * a load, which also works for unmanaged wrappers, whose native objects do not
+ * point to them through their user data.
+ *
+ * Objects are entered and looked up by every thread which creates objects or
+ * dispatches events of the display, e.g. through a proxy_wrapper or a
+ * display_reader, and insert() can reallocate a vector. All functions
+ * therefore take a mutex, which is not contended if only one thread uses the
+ * display. */
+class object_table {
+public:
+    static constexpr std::uint32_t server_id_start = 0xff000000;
+
+    object_table()
+        : _count(0) {
+    }
+
+    object_table(const object_table&) = delete;
+    object_table& operator=(const object_table&) = delete;
+
+    /* Wrapper of the object with the given id, or nullptr. */
+    proxy* find(std::uint32_t id) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const std::vector<proxy*>& slots = id < server_id_start ? _client : _server;
+        std::uint32_t index = id < server_id_start ? id : id - server_id_start;
+        return index < slots.size() ? slots[index] : nullptr;
+    }
+
+    /* Enter wrapper for id, replacing the previous wrapper, if any. */
+    void insert(std::uint32_t id, proxy* wrapper) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<proxy*>& slots = id < server_id_start ? _client : _server;
+        std::uint32_t index = id < server_id_start ? id : id - server_id_start;
+        if(index >= slots.size()) {
+            slots.resize(index + 1, nullptr);
+        }
+        if(slots[index] == nullptr) {
+            ++_count;
+        }
+        slots[index] = wrapper;
+    }
+
+    /* Remove the entry of id, if it still refers to wrapper. */
+    void erase(std::uint32_t id, const proxy* wrapper) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<proxy*>& slots = id < server_id_start ? _client : _server;
+        std::uint32_t index = id < server_id_start ? id : id - server_id_start;
+        if(index < slots.size() && slots[index] == wrapper) {
+            slots[index] = nullptr;
+            --_count;
+        }
+    }
+
+    /* Number of wrappers in the table. */
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _count;
+    }
+
+private:
+    std::vector<proxy*> _client;
+    std::vector<proxy*> _server;
+    std::size_t _count;
+    mutable std::mutex _mutex;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_OBJECT_TABLE_HPP_
+
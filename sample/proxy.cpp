@@ -1,30 +1,44 @@
 
 #include "proxy.hpp"
+#include "request_batch.hpp"
 
 using namespace std;
 using namespace wlcpp;
 
+thread_local request_batch* proxy::active_batch = nullptr;
+
 proxy::proxy(wl_proxy* proxy, bool managed)
     : _proxy(proxy),
-      _managed(managed) {
+      _table(nullptr),
+      _managed(managed),
+      _id(0) {
     set_user_data();
 }
 
 proxy::proxy(proxy& factory, const wl_interface& interface)
     : _proxy(wl_proxy_create(factory.wl_obj(), &interface)),
-      _managed(true) {
+      _table(nullptr),
+      _managed(true),
+      _id(0) {
     set_user_data();
+    set_object_table(factory._table);
 }
 
 proxy::proxy(proxy&& rhs)
     : _proxy(rhs.wl_obj()),
-      _managed(rhs._managed) {
+      _table(rhs._table),
+      _managed(rhs._managed),
+      _id(rhs._id) {
     set_user_data();
+    if(valid() && _table) {
+        _table->insert(_id, this);
+    }
     rhs.invalidate();
 }
 
 proxy::~proxy() {
     destroy();
+    invalidate();
 }
 
 bool proxy::valid() const {
@@ -36,6 +50,9 @@ bool proxy::managed() const {
 }
 
 void proxy::invalidate() {
+    if(valid() && _table) {
+        _table->erase(_id, this);
+    }
     _proxy = nullptr;
 }
 
@@ -59,11 +76,43 @@ void proxy::reset_queue() {
     wl_proxy_set_queue(_proxy, nullptr);
 }
 
+object_table* proxy::get_object_table() const {
+    return _table;
+}
+
+void proxy::set_object_table(object_table* table) {
+    if(valid() && _table) {
+        _table->erase(_id, this);
+    }
+    _table = table;
+    if(valid() && _table) {
+        _id = get_id();
+        _table->insert(_id, this);
+    }
+}
+
+void proxy::release_after_done() {
+    if(valid()) {
+        wl_proxy* obj = _proxy;
+        bool managed = _managed;
+        invalidate();
+        if(managed) {
+            wl_proxy_destroy(obj);
+        }
+    }
+}
+
 proxy& proxy::operator=(proxy&& rhs) {
     destroy();
+    invalidate();
     _proxy = rhs.wl_obj();
+    _table = rhs._table;
     _managed = rhs._managed;
+    _id = rhs._id;
     set_user_data();
+    if(valid() && _table) {
+        _table->insert(_id, this);
+    }
     rhs.invalidate();
     return *this;
 }
@@ -82,8 +131,9 @@ bool proxy::operator!=(const proxy& rhs) const {
 
 void proxy::destroy() {
     if(valid() && _managed) {
-        wl_proxy_destroy(_proxy);
+        wl_proxy* obj = _proxy;
         invalidate();
+        wl_proxy_destroy(obj);
     }
 }
 
@@ -93,3 +143,7 @@ void proxy::set_user_data() {
     }
 }
 
+void proxy::add_to_batch(const wl_message& message, const wl_argument* args) {
+    active_batch->add(message, args);
+}
+
@@ -2,20 +2,30 @@
 #ifndef _WLCPP_PROXY_HPP_
 #define _WLCPP_PROXY_HPP_
 
+#include <cstddef>
 #include <string>
 #include <utility>
 #include <wayland-client.h>
 #include "event_queue.hpp"
+#include "object_table.hpp"
 
 namespace wlcpp {
 
+class destruction_manager;
+class request_batch;
+class request_queue;
+
 class proxy {
 public:
     proxy(wl_proxy* proxy = nullptr, bool managed = true);
     proxy(proxy& factory, const wl_interface& interface);
     proxy(const proxy&) = delete;
     proxy(proxy&& rhs);
+#ifdef WLCPP_NONVIRTUAL_PROXY
+    ~proxy();
+#else
     virtual ~proxy();
+#endif
 
     bool valid() const;
     bool managed() const;
@@ -25,6 +35,14 @@ public:
     std::string get_class() const;
     void set_queue(event_queue& queue);
     void reset_queue();
+    object_table* get_object_table() const;
+    void set_object_table(object_table* table);
+
+    /* Destroy the native object of a wrapper whose object has been destroyed
+     * by the compositor, like a callback after done. The wrapper is
+     * invalidated, but keeps its handlers, so this can be called from one of
+     * them. */
+    void release_after_done();
 
     proxy& operator=(const proxy&) = delete;
     proxy& operator=(proxy&& rhs);
@@ -33,7 +51,11 @@ public:
     bool operator!=(const proxy& rhs) const;
 
 protected:
+#ifdef WLCPP_NONVIRTUAL_PROXY
+    void destroy();
+#else
     virtual void destroy();
+#endif
 
     template <typename T>
     static T* user_data_to_wrapper_cast(void* data) {
@@ -53,6 +75,47 @@ protected:
         return user_data_to_wrapper_cast<T>(wl_proxy_get_user_data(obj));
     }
 
+    /* Look up the wrapper of obj in the object table of the wrapper given as
+     * user data, e.g. for object arguments of its events. This also finds
+     * unmanaged wrappers. Objects which are not in the table are looked up
+     * through their user data. */
+    template <typename T>
+    static T* wrapper_cast(void* data, wl_proxy* obj) {
+        if(obj == nullptr) {
+            return nullptr;
+        }
+
+        proxy* owner = user_data_to_wrapper_cast<proxy>(data);
+        if(owner != nullptr && owner->_table != nullptr) {
+            proxy* wrapper = owner->_table->find(wl_proxy_get_id(obj));
+            if(wrapper != nullptr) {
+                return static_cast<T*>(wrapper);
+            }
+        }
+
+        return wrapper_cast<T>(obj);
+    }
+
+    /* Wrap an object created by a request of this object. The wrapper is
+     * entered into the object table of this object. */
+    template <typename T>
+    T wrap(wl_proxy* obj) const {
+        T result(obj);
+        result.set_object_table(_table);
+        return result;
+    }
+
+    /* Wrap an object created by an event of the wrapper given as user data. */
+    template <typename T>
+    static T wrap(void* data, wl_proxy* obj) {
+        proxy* owner = user_data_to_wrapper_cast<proxy>(data);
+        T result(obj);
+        if(owner != nullptr) {
+            result.set_object_table(owner->_table);
+        }
+        return result;
+    }
+
     template <typename T>
     void add_listener(const T& listener) {
         if(valid() && _managed && !wl_proxy_get_listener(_proxy)) {
@@ -62,16 +125,177 @@ protected:
         set_user_data();
     }
 
+    /* Install a dispatcher generated by wlcppgen --dispatcher. The listener is
+     * passed as dispatcher data, so wl_proxy_get_listener() still returns it.
+     * If WLCPP_LISTENER_DISPATCH is defined, the listener is installed instead. */
+    template <typename T>
+    void add_dispatcher(wl_dispatcher_func_t dispatcher, const T& listener) {
+#ifdef WLCPP_LISTENER_DISPATCH
+        add_listener(listener);
+#else
+        if(valid() && _managed && !wl_proxy_get_listener(_proxy)) {
+            wl_proxy_add_dispatcher(_proxy, dispatcher, &listener, this);
+        }
+
+        set_user_data();
+#endif
+    }
+
     template <typename... T>
     void marshal(std::uint32_t opcode, T&&... args) {
         wl_proxy_marshal(_proxy, opcode, std::forward<T>(args)...);
     }
 
+    /* Send a request whose arguments are already packed into wl_argument
+     * fields. Unlike marshal(), libwayland does not need to parse the
+     * signature to read the arguments from a va_list. message describes the
+     * request, it is only read if a request_batch is active. */
+    void marshal_array(std::uint32_t opcode, wl_argument* args, const wl_message& message) {
+        wl_proxy_marshal_array(_proxy, opcode, args);
+        if(active_batch != nullptr) {
+            add_to_batch(message, args);
+        }
+    }
+
+    /* Create a new object and send the request which creates it in one step.
+     * The new object uses the queue of this object. */
+    wl_proxy* marshal_array_constructor(std::uint32_t opcode, wl_argument* args, const wl_interface& interface, const wl_message& message) {
+        wl_proxy* result = wl_proxy_marshal_array_constructor(_proxy, opcode, args, &interface);
+        if(active_batch != nullptr) {
+            add_to_batch(message, args);
+        }
+        return result;
+    }
+
+    wl_proxy* marshal_array_constructor_versioned(std::uint32_t opcode, wl_argument* args, const wl_interface& interface, std::uint32_t version, const wl_message& message) {
+        wl_proxy* result = wl_proxy_marshal_array_constructor_versioned(_proxy, opcode, args, &interface, version);
+        if(active_batch != nullptr) {
+            add_to_batch(message, args);
+        }
+        return result;
+    }
+
 private:
+    friend class destruction_manager;
+    friend class event_loop;
+    friend class request_batch;
+    friend class request_queue;
+    template <typename T> friend class proxy_wrapper;
+
+    static void add_to_batch(const wl_message& message, const wl_argument* args);
     void set_user_data();
 
+    /* Innermost request_batch of the current thread. */
+    static thread_local request_batch* active_batch;
+
     wl_proxy* _proxy;
+    object_table* _table;
     bool _managed;
+    // Id under which the wrapper is entered into _table. The native object of
+    // an unmanaged wrapper may already be gone when the wrapper is invalidated.
+    std::uint32_t _id;
+};
+
+/* Entry of the table generated by wlcppgen --interface-table, which describes
+ * the class generated for an interface. create() wraps an object of the
+ * interface in a new instance of the class, which has to be deleted through
+ * destroy(), because the destructor of proxy may not be virtual. */
+struct interface_info {
+    const char* name;
+    std::size_t name_size;
+    const wl_interface* interface;
+    std::uint32_t version;
+    proxy* (*create)(wl_proxy* obj);
+    void (*destroy)(proxy* wrapper);
+
+    template <typename T>
+    static proxy* create_wrapper(wl_proxy* obj) {
+        return new T(obj);
+    }
+
+    template <typename T>
+    static void destroy_wrapper(proxy* wrapper) {
+        delete static_cast<T*>(wrapper);
+    }
+};
+
+/* Base class of classes generated by wlcppgen --proxy-base=proxy_base. Derived
+ * owns its destruction: its destructor calls its destroy(), and move assignment
+ * calls Derived::destroy() directly. If WLCPP_NONVIRTUAL_PROXY is defined, proxy
+ * has no virtual functions, so wrappers do not carry a vtable pointer. Wrappers
+ * must then not be destroyed through a pointer to proxy. */
+template <typename Derived>
+class proxy_base : public proxy {
+public:
+    proxy_base(wl_proxy* obj = nullptr, bool managed = true)
+        : proxy(obj, managed) {
+    }
+
+    proxy_base(proxy& factory, const wl_interface& interface)
+        : proxy(factory, interface) {
+    }
+
+    proxy_base(proxy_base&& rhs) = default;
+
+    proxy_base& operator=(proxy_base&& rhs) {
+        static_cast<Derived*>(this)->destroy();
+        proxy::operator=(std::move(rhs));
+        return *this;
+    }
+};
+
+/* Sends requests of an object on behalf of a thread with its own event queue.
+ * It wraps a wl_proxy created by wl_proxy_create_wrapper, which has the id of
+ * the object but its own queue. Objects created by requests through the
+ * wrapper are assigned to that queue when they are created, so none of their
+ * events can be dispatched on another thread, and they are entered into the
+ * object table of the object. The wrapper receives no events. */
+template <typename T>
+class proxy_wrapper {
+public:
+    proxy_wrapper(T& obj, event_queue& queue)
+        : _wrapper(static_cast<wl_proxy*>(wl_proxy_create_wrapper(obj.proxy::wl_obj())), false) {
+        if(_wrapper.valid()) {
+            wl_proxy_set_queue(_wrapper.proxy::wl_obj(), queue.wl_obj());
+        }
+        _wrapper._table = obj._table;
+    }
+
+    proxy_wrapper(const proxy_wrapper&) = delete;
+    proxy_wrapper(proxy_wrapper&& rhs)
+        : _wrapper(rhs._wrapper.proxy::wl_obj(), false) {
+        _wrapper._table = rhs._wrapper._table;
+        rhs._wrapper.invalidate();
+    }
+
+    ~proxy_wrapper() {
+        if(_wrapper.valid()) {
+            wl_proxy* obj = _wrapper.proxy::wl_obj();
+            _wrapper.invalidate();
+            wl_proxy_wrapper_destroy(obj);
+        }
+    }
+
+    proxy_wrapper& operator=(const proxy_wrapper&) = delete;
+
+    T& operator*() {
+        return _wrapper;
+    }
+
+    const T& operator*() const {
+        return _wrapper;
+    }
+
+    T* operator->() {
+        return &_wrapper;
+    }
+
+    const T* operator->() const {
+        return &_wrapper;
+    }
+
+private:
+    T _wrapper;
 };
 
 } // namespace wlcpp
@@ -0,0 +1,116 @@
+
+#include <cstring>
+#include "request_batch.hpp"
+#include "generated/display.hpp"
+#include "generated/surface.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+namespace {
+
+uint32_t padded(size_t size) {
+    return static_cast<uint32_t>((size + 3) & ~static_cast<size_t>(3));
+}
+
+// Size of a message on the wire, see wl_closure_marshal in libwayland. File
+// descriptors are passed out of band.
+size_t wire_size(const wl_message& message, const wl_argument* args) {
+    size_t size = 8;
+    size_t index = 0;
+    for(const char* c = message.signature; *c; ++c) {
+        switch(*c) {
+        case 'i':
+        case 'u':
+        case 'f':
+        case 'o':
+        case 'n':
+            size += 4;
+            break;
+        case 's':
+            size += 4;
+            if(args[index].s) {
+                size += padded(strlen(args[index].s) + 1);
+            }
+            break;
+        case 'a':
+            size += 4;
+            if(args[index].a) {
+                size += padded(args[index].a->size);
+            }
+            break;
+        case 'h':
+            break;
+        default:
+            continue;
+        }
+        ++index;
+    }
+    return size;
+}
+
+bool is_commit(const wl_message& message) {
+    const wl_message* methods = surface::interface.methods;
+    return &message >= methods && &message < methods + surface::interface.method_count && strcmp(message.name, "commit") == 0;
+}
+
+} // namespace
+
+request_batch::request_batch(display& d, const flush_policy& policy)
+    : _display(d),
+      _policy(policy),
+      _stats(),
+      _pending_messages(0),
+      _pending_bytes(0),
+      _outer(proxy::active_batch) {
+    proxy::active_batch = this;
+}
+
+request_batch::~request_batch() {
+    flush();
+    proxy::active_batch = _outer;
+}
+
+int request_batch::idle() {
+    if(!_policy.on_idle) {
+        return 0;
+    }
+    return flush();
+}
+
+int request_batch::flush() {
+    int result = _display.flush();
+    if(result > 0 || (result == 0 && _pending_messages > 0)) {
+        ++_stats.flushes;
+        _stats.messages += _pending_messages;
+        _stats.bytes += _pending_bytes;
+        _pending_messages = 0;
+        _pending_bytes = 0;
+    }
+    return result;
+}
+
+const flush_policy& request_batch::policy() const {
+    return _policy;
+}
+
+const flush_stats& request_batch::stats() const {
+    return _stats;
+}
+
+size_t request_batch::pending_messages() const {
+    return _pending_messages;
+}
+
+size_t request_batch::pending_bytes() const {
+    return _pending_bytes;
+}
+
+void request_batch::add(const wl_message& message, const wl_argument* args) {
+    ++_pending_messages;
+    _pending_bytes += wire_size(message, args);
+
+    if((_policy.on_commit && is_commit(message)) || (_policy.byte_threshold > 0 && _pending_bytes >= _policy.byte_threshold)) {
+        flush();
+    }
+}
@@ -0,0 +1,82 @@
+
+#ifndef _WLCPP_REQUEST_BATCH_HPP_
+#define _WLCPP_REQUEST_BATCH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <wayland-client.h>
+
+namespace wlcpp {
+
+class display;
+
+/* When a request_batch flushes the display. A batch always flushes when it
+ * ends. */
+struct flush_policy {
+    flush_policy(bool on_commit = false, bool on_idle = true, std::size_t byte_threshold = 0)
+        : on_commit(on_commit),
+          on_idle(on_idle),
+          byte_threshold(byte_threshold) {
+    }
+
+    /* Flush right after wl_surface.commit. */
+    bool on_commit;
+
+    /* Flush in request_batch::idle(), which the event loop calls before it
+     * waits for events. */
+    bool on_idle;
+
+    /* Flush as soon as at least this many bytes are buffered. 0 disables the
+     * threshold. libwayland flushes by itself when its buffer of 4096 bytes is
+     * full. */
+    std::size_t byte_threshold;
+};
+
+/* Counters of the flushes of a request_batch. Bytes are those of the messages
+ * sent through generated requests, as encoded on the wire. */
+struct flush_stats {
+    std::uint64_t flushes;
+    std::uint64_t messages;
+    std::uint64_t bytes;
+};
+
+/* Scope in which the requests sent by the current thread are collected and
+ * flushed according to a flush_policy. Batches can be nested, the innermost
+ * one collects the requests. */
+class request_batch {
+public:
+    explicit request_batch(display& d, const flush_policy& policy = flush_policy());
+    request_batch(const request_batch&) = delete;
+    ~request_batch();
+
+    request_batch& operator=(const request_batch&) = delete;
+
+    /* Flush if the policy flushes on idle. Returns the result of
+     * wl_display_flush, or 0 if nothing was flushed. */
+    int idle();
+
+    /* Flush the display now. Returns the result of wl_display_flush. */
+    int flush();
+
+    const flush_policy& policy() const;
+    const flush_stats& stats() const;
+    std::size_t pending_messages() const;
+    std::size_t pending_bytes() const;
+
+private:
+    friend class proxy;
+
+    void add(const wl_message& message, const wl_argument* args);
+
+    display& _display;
+    flush_policy _policy;
+    flush_stats _stats;
+    std::size_t _pending_messages;
+    std::size_t _pending_bytes;
+    request_batch* _outer;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_REQUEST_BATCH_HPP_
+
@@ -0,0 +1,130 @@
+
+#include <algorithm>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "request_batch.hpp"
+#include "request_queue.hpp"
+
+using namespace std;
+using namespace wlcpp;
+
+constexpr size_t request_queue::max_args;
+
+request_queue::request_queue(size_t capacity)
+    : _mask(1),
+      _fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+      _stats(),
+      _enqueue_position(0),
+      _signalled(false),
+      _rejected(0),
+      _dequeue_position(0) {
+    while(_mask + 1 < capacity) {
+        _mask = 2 * _mask + 1;
+    }
+
+    _slots.reset(new slot[_mask + 1]);
+    for(size_t i = 0; i <= _mask; ++i) {
+        _slots[i].sequence.store(i, memory_order_relaxed);
+    }
+}
+
+request_queue::~request_queue() {
+    if(_fd >= 0) {
+        close(_fd);
+    }
+}
+
+size_t request_queue::drain() {
+    // The eventfd is not readable if nothing was pushed since the last drain.
+    // Requests published before a producer found _signalled set are visible
+    // after the exchange, later producers write to the eventfd again.
+    uint64_t value;
+    if(read(_fd, &value, sizeof(value)) < 0) {
+        value = 0;
+    }
+    _signalled.exchange(false, memory_order_acq_rel);
+
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    size_t position = _dequeue_position.load(memory_order_relaxed);
+    size_t count = 0;
+    while(true) {
+        slot& s = _slots[position & _mask];
+        if(s.sequence.load(memory_order_acquire) != position + 1) {
+            break;
+        }
+
+        wl_proxy_marshal_array(s.target, s.opcode, s.args);
+        if(proxy::active_batch != nullptr) {
+            proxy::add_to_batch(*s.message, s.args);
+        }
+
+        // Requests published while the drain runs count as not having waited.
+        uint64_t latency = 0;
+        if(s.time < now) {
+            latency = chrono::duration_cast<chrono::nanoseconds>(now - s.time).count();
+        }
+        _stats.total_latency_ns += latency;
+        _stats.max_latency_ns = max(_stats.max_latency_ns, latency);
+
+        s.sequence.store(position + _mask + 1, memory_order_release);
+        ++position;
+        ++count;
+    }
+    _dequeue_position.store(position, memory_order_relaxed);
+
+    if(count > 0) {
+        ++_stats.drains;
+        _stats.requests += count;
+        _stats.max_depth = max(_stats.max_depth, count);
+    }
+    return count;
+}
+
+size_t request_queue::depth() const {
+    size_t dequeued = _dequeue_position.load(memory_order_relaxed);
+    return _enqueue_position.load(memory_order_relaxed) - dequeued;
+}
+
+int request_queue::get_fd() const {
+    return _fd;
+}
+
+request_queue_stats request_queue::stats() const {
+    request_queue_stats result = _stats;
+    result.rejected = _rejected.load(memory_order_relaxed);
+    return result;
+}
+
+request_queue::slot* request_queue::claim(size_t& position) {
+    position = _enqueue_position.load(memory_order_relaxed);
+    while(true) {
+        slot& s = _slots[position & _mask];
+        size_t sequence = s.sequence.load(memory_order_acquire);
+        if(sequence == position) {
+            if(_enqueue_position.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                return &s;
+            }
+        }
+        else if(sequence < position) {
+            // The slot still holds the request from the previous round.
+            _rejected.fetch_add(1, memory_order_relaxed);
+            return nullptr;
+        }
+        else {
+            position = _enqueue_position.load(memory_order_relaxed);
+        }
+    }
+}
+
+void request_queue::publish(slot& s, size_t position) {
+    s.time = chrono::steady_clock::now();
+    s.sequence.store(position + 1, memory_order_release);
+    if(_signalled.exchange(true, memory_order_acq_rel)) {
+        return;
+    }
+
+    uint64_t value = 1;
+    if(write(_fd, &value, sizeof(value)) < 0) {
+        return;
+    }
+}
@@ -0,0 +1,116 @@
+
+#ifndef _WLCPP_REQUEST_QUEUE_HPP_
+#define _WLCPP_REQUEST_QUEUE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <wayland-client.h>
+#include "proxy.hpp"
+
+namespace wlcpp {
+
+/* Counters of a request_queue. Latency is the time from push() until drain()
+ * started to send the request. The depth is the number of requests a drain
+ * found, so requests / drains is the average depth. */
+struct request_queue_stats {
+    std::uint64_t drains;
+    std::uint64_t requests;
+    std::uint64_t rejected;
+    std::size_t max_depth;
+    std::uint64_t total_latency_ns;
+    std::uint64_t max_latency_ns;
+};
+
+/* Bounded queue through which other threads send requests on behalf of the
+ * thread which dispatches the display.
+ *
+ * Producers store the arguments of a request in a slot of a ring buffer,
+ * using the <request>_args structs generated by wlcppgen --request-args, e.g.
+ * push(s, surface::damage_args{ 0, 0, 64, 64 }). Slots are claimed with a
+ * compare-and-swap and published through a sequence number per slot, so
+ * producers never take a lock. The display thread sends all published requests
+ * in one batch by calling drain(), before it flushes the display. get_fd() is
+ * an eventfd which becomes readable when requests were pushed after the last
+ * drain; it is written to once per drain at most.
+ *
+ * Requests are sent in the order in which their slots were claimed. The target
+ * and the objects among the arguments must stay alive until their request has
+ * been drained.
+ */
+class request_queue {
+public:
+    static constexpr std::size_t max_args = 8;
+
+    /* capacity is rounded up to a power of two. */
+    explicit request_queue(std::size_t capacity = 1024);
+    request_queue(const request_queue&) = delete;
+    ~request_queue();
+
+    request_queue& operator=(const request_queue&) = delete;
+
+    /* Queue a request of target. Can be called from any thread. Returns false
+     * if the queue is full. */
+    template <typename Args>
+    bool push(const proxy& target, const Args& args) {
+        static_assert(Args::arg_count <= max_args, "request has too many arguments for request_queue");
+
+        std::size_t position;
+        slot* s = claim(position);
+        if(s == nullptr) {
+            return false;
+        }
+
+        s->target = target.wl_obj();
+        s->message = &Args::message();
+        s->opcode = Args::opcode;
+        args.pack(s->args);
+        publish(*s, position);
+        return true;
+    }
+
+    /* Send all queued requests. Must be called by the thread which dispatches
+     * the display. Returns the number of requests sent. */
+    std::size_t drain();
+
+    /* Number of requests which have been pushed but not drained yet. */
+    std::size_t depth() const;
+
+    int get_fd() const;
+
+    /* Counters, which are updated by drain(). */
+    request_queue_stats stats() const;
+
+private:
+    struct slot {
+        std::atomic<std::size_t> sequence;
+        wl_proxy* target;
+        const wl_message* message;
+        std::uint32_t opcode;
+        std::chrono::steady_clock::time_point time;
+        wl_argument args[max_args];
+    };
+
+    slot* claim(std::size_t& position);
+    void publish(slot& s, std::size_t position);
+
+    std::unique_ptr<slot[]> _slots;
+    std::size_t _mask;
+    int _fd;
+    request_queue_stats _stats;
+
+    // Producers and the consumer write different cache lines.
+    char _padding0[64];
+    std::atomic<std::size_t> _enqueue_position;
+    std::atomic<bool> _signalled;
+    std::atomic<std::uint64_t> _rejected;
+    char _padding1[64];
+    std::atomic<std::size_t> _dequeue_position;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_REQUEST_QUEUE_HPP_
+
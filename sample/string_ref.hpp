@@ -0,0 +1,120 @@
+#ifndef _WLCPP_STRING_REF_HPP_
+#define _WLCPP_STRING_REF_HPP_
+
+#if __cplusplus >= 201703L
+
+#include <string_view>
+
+namespace wlcpp {
+
+using string_ref = std::string_view;
+
+} // namespace wlcpp
+
+#else
+
+#include <cstddef>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+
+namespace wlcpp {
+
+/** \brief Non-owning reference to a string
+ *
+ *  Subset of std::string_view for C++11. The referenced characters are not
+ *  copied, so a string_ref passed to an event handler is only valid until the
+ *  handler returns. Use std::string(ref) to keep a copy.
+ */
+class string_ref {
+public:
+    using const_iterator = const char*;
+
+    string_ref()
+        : _data(nullptr),
+          _size(0) {
+    }
+
+    string_ref(const char* str)
+        : _data(str),
+          _size(std::strlen(str)) {
+    }
+
+    string_ref(const char* str, std::size_t size)
+        : _data(str),
+          _size(size) {
+    }
+
+    string_ref(const std::string& str)
+        : _data(str.data()),
+          _size(str.size()) {
+    }
+
+    const char* data() const {
+        return _data;
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    std::size_t length() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    const_iterator begin() const {
+        return _data;
+    }
+
+    const_iterator end() const {
+        return _data + _size;
+    }
+
+    char operator[](std::size_t pos) const {
+        return _data[pos];
+    }
+
+    int compare(string_ref rhs) const {
+        std::size_t size = _size < rhs._size ? _size : rhs._size;
+        int result = size > 0 ? std::memcmp(_data, rhs._data, size) : 0;
+        if(result == 0 && _size != rhs._size) {
+            result = _size < rhs._size ? -1 : 1;
+        }
+        return result;
+    }
+
+    explicit operator std::string() const {
+        return std::string(_data, _size);
+    }
+
+private:
+    const char* _data;
+    std::size_t _size;
+};
+
+inline bool operator==(string_ref lhs, string_ref rhs) {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+inline bool operator!=(string_ref lhs, string_ref rhs) {
+    return !(lhs == rhs);
+}
+
+inline bool operator<(string_ref lhs, string_ref rhs) {
+    return lhs.compare(rhs) < 0;
+}
+
+template <typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, string_ref str) {
+    return os.write(str.data(), str.size());
+}
+
+} // namespace wlcpp
+
+#endif
+
+#endif // _WLCPP_STRING_REF_HPP_
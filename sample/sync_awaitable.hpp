@@ -0,0 +1,51 @@
+
+#ifndef _WLCPP_SYNC_AWAITABLE_HPP_
+#define _WLCPP_SYNC_AWAITABLE_HPP_
+
+#include <coroutine>
+#include <cstdint>
+#include <utility>
+#include "sync_future.hpp"
+
+namespace wlcpp {
+
+/* Makes a sync_future awaitable in C++20 coroutines:
+ *
+ *     std::uint32_t serial = co_await sync_future(display);
+ *
+ * The coroutine is suspended until the done event and resumed from the event
+ * loop which dispatches it. No coroutine return type is provided, because it
+ * depends on how the application runs and owns its coroutines.
+ */
+class sync_awaitable {
+public:
+    explicit sync_awaitable(sync_future&& future)
+        : _future(std::move(future)) {
+    }
+
+    bool await_ready() const {
+        return _future.ready();
+    }
+
+    void await_suspend(std::coroutine_handle<> coroutine) {
+        _future.then([coroutine](std::uint32_t) {
+            coroutine.resume();
+        });
+    }
+
+    std::uint32_t await_resume() const {
+        return _future.serial();
+    }
+
+private:
+    sync_future _future;
+};
+
+inline sync_awaitable operator co_await(sync_future&& future) {
+    return sync_awaitable(std::move(future));
+}
+
+} // namespace wlcpp
+
+#endif // _WLCPP_SYNC_AWAITABLE_HPP_
+
@@ -0,0 +1,118 @@
+
+#ifndef _WLCPP_SYNC_FUTURE_HPP_
+#define _WLCPP_SYNC_FUTURE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "delegate.hpp"
+#include "generated/callback.hpp"
+#include "generated/display.hpp"
+
+namespace wlcpp {
+
+/* Result of a roundtrip which does not block, based on display::sync().
+ *
+ * Creating a sync_future sends wl_display.sync. The continuation passed to
+ * then() is called from the event loop with the serial of the done event, once
+ * the compositor has processed all requests sent before. Any number of futures
+ * can be pending at the same time, so independent roundtrips overlap instead
+ * of costing one round trip time each, and a continuation can start the next
+ * roundtrip. A future can be moved and destroyed while it is pending, which
+ * cancels its continuation, also from within its own continuation.
+ *
+ * With C++20, sync_awaitable.hpp makes a sync_future awaitable.
+ */
+class sync_future {
+public:
+    using continuation_sig = void (std::uint32_t serial);
+
+    /** \brief Create an empty future */
+    sync_future() = default;
+
+    /** \brief Send wl_display.sync through d */
+    explicit sync_future(display& d)
+        : sync_future(d.sync()) {
+    }
+
+    /** \brief Wait for the done event of a callback returned by a sync request,
+     *  e.g. through a proxy_wrapper<display> for another event_queue
+     */
+    explicit sync_future(callback&& cb)
+        : _state(new state()) {
+        state* s = _state.get();
+        s->cb = std::move(cb);
+        s->cb.set_done_handler([s](std::uint32_t serial) {
+            done(*s, serial);
+        });
+    }
+
+    sync_future(sync_future&&) = default;
+    sync_future& operator=(sync_future&&) = default;
+
+    /** \brief Set the function which is called once the roundtrip completed
+     *
+     *  If the roundtrip already completed, the continuation is called immediately.
+     */
+    template <typename T>
+    void then(T&& continuation) {
+        if(!_state) {
+            return;
+        }
+
+        if(_state->ready) {
+            delegate<continuation_sig>(std::forward<T>(continuation))(_state->serial);
+        }
+        else {
+            _state->continuation = delegate<continuation_sig>(std::forward<T>(continuation));
+        }
+    }
+
+    /** \brief Whether the future refers to a roundtrip */
+    bool valid() const {
+        return static_cast<bool>(_state);
+    }
+
+    /** \brief Whether the done event was received */
+    bool ready() const {
+        return _state && _state->ready;
+    }
+
+    /** \brief Serial of the done event, valid once ready() */
+    std::uint32_t serial() const {
+        return _state ? _state->serial : 0;
+    }
+
+private:
+    struct state {
+        state()
+            : serial(0),
+              ready(false) {
+        }
+
+        callback cb;
+        delegate<continuation_sig> continuation;
+        std::uint32_t serial;
+        bool ready;
+    };
+
+    static void done(state& s, std::uint32_t serial) {
+        // The continuation may destroy the future and with it s, so s is not
+        // accessed once it has been called.
+        s.cb.release_after_done();
+
+        s.serial = serial;
+        s.ready = true;
+        delegate<continuation_sig> continuation(std::move(s.continuation));
+        if(continuation) {
+            continuation(serial);
+        }
+    }
+
+    std::unique_ptr<state> _state;
+};
+
+} // namespace wlcpp
+
+#endif // _WLCPP_SYNC_FUTURE_HPP_
+
@@ -15,9 +15,14 @@
 # PERFORMANCE OF THIS SOFTWARE.
 
 wlcppgen_version = (0, 1, 0)
+manifest_filename = '.wlcppgen-manifest'
 
 import sys
+import copy
 import getopt
+import hashlib
+import json
+import os
 import xml.etree.ElementTree
 
 def mangle_interface_name(name, options):
@@ -41,6 +46,20 @@ def filter_interfaces(interfaces, options):
             result.append(interface)
     return result
 
+def handler_type(options):
+    if options.handler_type is not None:
+        return options.handler_type
+    elif options.qualify_std_namespace:
+        return 'std::function'
+    else:
+        return 'function'
+
+def forward_header(spec, options):
+    return options.forward_header.replace('%s', spec.name)
+
+def interface_table_header(spec):
+    return identifier(spec.name) + '_interfaces.hpp'
+
 def single_interface_mode(options):
     return len(options.only) == 1
 
@@ -174,9 +193,10 @@ class Description:
         return result
 
 class Argument:
-    def __init__(self, root):
+    def __init__(self, root, message_path):
         self.root = root
         self.name = self.root.get('name')
+        self.path = message_path + '.' + self.name
         self.argument_type = self.root.get('type')
         self.interface = self.root.get('interface')
         self.allow_null = self.root.get('allow-null') == 'true'
@@ -209,13 +229,36 @@ class Argument:
             elif self.interface is None and self.allow_null:
                 return options.proxy + '*'
         elif self.argument_type == 'array':
-            if self.allow_null:
+            if self.has_array_view(options):
+                if self.allow_null:
+                    return 'const ' + self.generate_array_view_type(options) + '*'
+                else:
+                    return self.generate_array_view_type(options)
+            elif self.allow_null:
                 return 'const wl_array*'
             else:
                 return 'const wl_array&'
         elif self.argument_type == 'fd':
             return std_namespace + 'int32_t'
 
+    def has_array_view(self, options):
+        return len(options.array_view) > 0 and self.path in options.array_types
+
+    def generate_array_view_type(self, options):
+        if options.qualify_std_namespace:
+            std_namespace = 'std::'
+        else:
+            std_namespace = str()
+
+        element_type = options.array_types[self.path]
+        if element_type == 'int':
+            element_type = std_namespace + 'int32_t'
+        elif element_type == 'uint':
+            element_type = std_namespace + 'uint32_t'
+        elif element_type == 'fixed':
+            element_type = 'wl_fixed_t'
+        return options.array_view + '<const ' + element_type + '>'
+
     def generate_request_return_type(self, options):
         if self.argument_type == 'new_id':
             if self.interface is None:
@@ -234,6 +277,11 @@ class Argument:
             else:
                 result += '&&'
             return result
+        elif self.argument_type == 'string' and len(options.string_ref) > 0:
+            if self.allow_null:
+                return 'const ' + options.string_ref + '*'
+            else:
+                return options.string_ref
         else:
             return self.generate_request_parameter_type(options)
 
@@ -263,8 +311,66 @@ class Argument:
         elif self.argument_type == 'new_id':
             return 'wl_proxy*'
 
+    def generate_marshal_values(self, options):
+        """Return the wl_argument fields and values which pass this argument to
+        wl_proxy_marshal_array. Untyped new_id arguments take three fields. The
+        new_id itself is filled in by wl_proxy_marshal_array_constructor."""
+        name = mangle_argument_name(self.name)
+        if self.argument_type == 'int':
+            return [('i', name)]
+        elif self.argument_type == 'uint':
+            return [('u', name)]
+        elif self.argument_type == 'fixed':
+            return [('f', name)]
+        elif self.argument_type == 'string':
+            if self.allow_null:
+                return [('s', name + ' ? ' + name + '->c_str() : nullptr')]
+            else:
+                return [('s', name + '.c_str()')]
+        elif self.argument_type == 'object':
+            if self.allow_null:
+                return [('o', name + ' ? reinterpret_cast<wl_object*>(' + name + '->wl_obj()) : nullptr')]
+            else:
+                return [('o', 'reinterpret_cast<wl_object*>(' + name + '.wl_obj())')]
+        elif self.argument_type == 'new_id':
+            result = list()
+            if self.interface is None:
+                result.append(('s', 'T::interface.name'))
+                result.append(('u', mangle_argument_name('version')))
+            result.append(('o', 'nullptr'))
+            return result
+        elif self.argument_type == 'array':
+            if self.has_array_view(options):
+                if self.allow_null:
+                    return [('a', name + ' ? &' + self.name + '_array : nullptr')]
+                else:
+                    return [('a', '&' + self.name + '_array')]
+            elif self.allow_null:
+                return [('a', 'const_cast<wl_array*>(' + name + ')')]
+            else:
+                return [('a', 'const_cast<wl_array*>(&' + name + ')')]
+        elif self.argument_type == 'fd':
+            return [('h', name)]
+
+    def generate_dispatch_argument(self, index):
+        argument = 'args[' + str(index) + ']'
+        if self.argument_type == 'int':
+            return argument + '.i'
+        elif self.argument_type == 'uint':
+            return argument + '.u'
+        elif self.argument_type == 'fixed':
+            return argument + '.f'
+        elif self.argument_type == 'string':
+            return argument + '.s'
+        elif self.argument_type == 'object' or self.argument_type == 'new_id':
+            return 'reinterpret_cast<wl_proxy*>(' + argument + '.o)'
+        elif self.argument_type == 'array':
+            return argument + '.a'
+        elif self.argument_type == 'fd':
+            return argument + '.h'
+
 class Request:
-    def __init__(self, root, opcode):
+    def __init__(self, root, opcode, interface_name):
         self.root = root
         self.opcode = opcode
         self.name = self.root.get('name')
@@ -276,7 +382,7 @@ class Request:
         self.return_argument = None
 
         for argument in self.root.iter('arg'):
-            new_argument = Argument(argument)
+            new_argument = Argument(argument, interface_name + '.' + self.name)
             if new_argument.argument_type == 'new_id':
                 if self.return_argument is not None:
                     raise ProtocolError('More than one new_id argument found in request ' + self.name)
@@ -341,59 +447,106 @@ class Request:
         result.append(self.generate_signature(options, class_name) + ' {')
 
         body = list()
-        if self.return_argument is not None:
-            return_var = str()
-            if self.return_argument.interface is not None:
-                return_var += mangle_interface_name(self.return_argument.interface, options) + ' ' + mangle_argument_name(self.return_argument.name) + '(*this);'
-            else:
-                return_var += 'T ' + mangle_argument_name(self.return_argument.name) + '(*this);'
-            body.append(return_var)
-
-        marshal_call = 'marshal(' + str(self.opcode)
         for argument in self.arguments:
-            marshal_call += ', '
-            if argument.argument_type == 'new_id' and argument.interface is None:
-                marshal_call += 'T::interface.name, ' + mangle_argument_name('version') + ', '
-            if argument.argument_type == 'new_id':
-                marshal_call += mangle_argument_name(argument.name) + '.wl_obj()'
-            elif argument.argument_type == 'string' and argument.allow_null:
-                marshal_call += mangle_argument_name(argument.name) + ' ? ' + mangle_argument_name(argument.name) + '->c_str() : nullptr'
-            elif argument.argument_type == 'string' and not argument.allow_null:
-                marshal_call += mangle_argument_name(argument.name) + '.c_str()'
-            elif argument.argument_type == 'object' and argument.allow_null:
-                marshal_call += mangle_argument_name(argument.name) + ' ? ' + mangle_argument_name(argument.name) + '->wl_obj() : nullptr'
-            elif argument.argument_type == 'object' and not argument.allow_null:
-                marshal_call += mangle_argument_name(argument.name) + '.wl_obj()'
-            else:
-                marshal_call += mangle_argument_name(argument.name)
-        marshal_call += ');'
-        body.append(marshal_call)
+            if argument.argument_type == 'array' and argument.has_array_view(options):
+                if argument.allow_null:
+                    body.append('wl_array ' + argument.name + '_array = ' + mangle_argument_name(argument.name) + ' ? ' + mangle_argument_name(argument.name) + '->to_wl_array() : wl_array();')
+                else:
+                    body.append('wl_array ' + argument.name + '_array = ' + mangle_argument_name(argument.name) + '.to_wl_array();')
 
-        if self.return_argument is not None:
-            body.append('return ' + mangle_argument_name(self.return_argument.name) + ';')
+        values = list()
+        for argument in self.arguments:
+            values.extend(argument.generate_marshal_values(options))
+        if len(values) > 0:
+            body.append('wl_argument args[' + str(len(values)) + '];')
+            for index, (field, value) in enumerate(values):
+                body.append('args[' + str(index) + '].' + field + ' = ' + value + ';')
+            args = 'args'
+        else:
+            args = 'nullptr'
+
+        # The new object is created and the request is sent under the same lock,
+        # and the new object inherits the queue and the object table of this one.
+        message = 'interface.methods[' + str(self.opcode) + ']'
+        if self.return_argument is None:
+            body.append('marshal_array(' + str(self.opcode) + ', ' + args + ', ' + message + ');')
+        elif self.return_argument.interface is None:
+            body.append('return wrap<T>(marshal_array_constructor_versioned(' + str(self.opcode) + ', ' + args + ', T::interface, ' + mangle_argument_name('version') + ', ' + message + '));')
+        else:
+            class_name = mangle_interface_name(self.return_argument.interface, options)
+            body.append('return wrap<' + class_name + '>(marshal_array_constructor(' + str(self.opcode) + ', ' + args + ', ' + class_name + '::interface, ' + message + '));')
 
         result.append(body)
         result.append('}')
         return result
 
-    def generate_types_array(self, options, interface):
-        result = 'static const wl_interface* ' + interface.name + '_request_' + self.name + '_types[] = { '
+    def has_args_struct(self):
+        """Whether the arguments of this request can be stored in a POD struct
+        which does not refer to memory owned by the caller, so the request can
+        be sent later, e.g. by another thread."""
+        if self.is_destructor:
+            return False
+        for argument in self.arguments:
+            if argument.argument_type not in ['int', 'uint', 'fixed', 'object']:
+                return False
+        return True
+
+    def generate_args_struct(self, options):
+        if options.qualify_std_namespace:
+            std_namespace = 'std::'
+        else:
+            std_namespace = str()
+
+        fields = list()
+        pack = list()
+        for index, argument in enumerate(self.arguments):
+            name = mangle_argument_name(argument.name)
+            fields.append(argument.generate_native_type(options) + ' ' + name + ';')
+            if argument.argument_type == 'object':
+                pack.append('args[' + str(index) + '].o = reinterpret_cast<wl_object*>(' + name + ');')
+            else:
+                field, value = argument.generate_marshal_values(options)[0]
+                pack.append('args[' + str(index) + '].' + field + ' = ' + name + ';')
+
+        body = [
+            'static constexpr ' + std_namespace + 'uint32_t opcode = ' + str(self.opcode) + ';',
+            'static constexpr ' + std_namespace + 'uint32_t arg_count = ' + str(len(self.arguments)) + ';'
+        ]
+        if len(fields) > 0:
+            body.append('')
+            body.extend(fields)
+        body.append('')
+        body.extend([
+            'static const wl_message& message() {',
+            ['return interface.methods[opcode];'],
+            '}'
+        ])
+        body.append('')
+        if len(pack) > 0:
+            body.extend(['void pack(wl_argument* args) const {', pack, '}'])
+        else:
+            body.append('void pack(wl_argument*) const {')
+            body.append('}')
+
+        return [
+            '/** \\brief Arguments of @ref ' + self.name + ', objects are passed as native objects */',
+            'struct ' + self.name + '_args {',
+            body,
+            '};'
+        ]
+
+    def generate_types(self, options):
+        result = list()
         for argument in self.arguments:
             if argument.argument_type == 'new_id' and argument.interface is None:
-                result += 'nullptr, nullptr, nullptr'
+                result.extend(['nullptr', 'nullptr', 'nullptr'])
             elif (argument.interface is not None) and (argument.argument_type == 'new_id' or argument.argument_type == 'object'):
-                result += '&' + mangle_interface_name(argument.interface, options) + '::interface'
+                result.append('&' + mangle_interface_name(argument.interface, options) + '::interface')
             else:
-                result += 'nullptr'
-
-            if argument != self.arguments[-1]:
-                result += ', '
-        if len(self.arguments) > 0:
-            result += ' '
-        result += '};'
+                result.append('nullptr')
         return result
 
-    def generate_wl_message(self, options, interface):
+    def generate_wl_message(self, options, message_types):
         result = '{ "' + self.name + '", "'
         if self.since > 1:
             result += str(self.since)
@@ -418,11 +571,11 @@ class Request:
                 if argument.interface is None:
                     result += 'su'
                 result += 'n'
-        result += '", ' + interface.name + '_request_' + self.name + '_types }'
+        result += '", ' + message_types.generate_reference(self.generate_types(options)) + ' }'
         return result
 
 class Event:
-    def __init__(self, root, index):
+    def __init__(self, root, index, interface_name):
         self.root = root
         self.index = index
         self.name = self.root.get('name')
@@ -431,7 +584,7 @@ class Event:
         self.arguments = list()
 
         for argument in self.root.iter('arg'):
-            self.arguments.append(Argument(argument))
+            self.arguments.append(Argument(argument, interface_name + '.' + self.name))
 
     def required_interfaces(self, options):
         result = set()
@@ -451,7 +604,15 @@ class Event:
         result.append(signature)
         return result
 
-    def generate_set_handler_method(self, options):
+    def has_inline_handler(self, options, interface):
+        return options.handler_storage == 'inline' or (interface.name + '.' + self.name) in options.inline_handlers
+
+    def generate_set_handler_method(self, options, interface):
+        if self.has_inline_handler(options, interface):
+            member = '_' + self.name + '_handler'
+        else:
+            member = 'handlers()._' + self.name + '_handler'
+
         if options.qualify_std_namespace:
             std_namespace = 'std::'
         else:
@@ -463,19 +624,14 @@ class Event:
             ' */',
             'template <typename T>',
             'void set_' + self.name + '_handler(T&& handler) {', [
-                '_' + self.name + '_handler = ' + std_namespace + 'function<' + self.name + '_handler_sig>(' + std_namespace + 'forward<T>(handler));'
+                member + ' = ' + handler_type(options) + '<' + self.name + '_handler_sig>(' + std_namespace + 'forward<T>(handler));'
             ],
             '}'
         ]
         return result
 
     def generate_function_member(self, options):
-        if options.qualify_std_namespace:
-            std_namespace = 'std::'
-        else:
-            std_namespace = str()
-
-        return std_namespace + 'function<' + self.name + '_handler_sig> _' + self.name + '_handler;'
+        return handler_type(options) + '<' + self.name + '_handler_sig> _' + self.name + '_handler;'
 
     def generate_handler_ptr(self, options, interface):
         result = 'void (*' + self.name + '_handler) (void*, wl_proxy*'
@@ -497,71 +653,120 @@ class Event:
         result += ')'
         return result
 
-    def generate_handler(self, options, interface):
+    def generate_handler_locals(self, options):
         if options.qualify_std_namespace:
             std_namespace = 'std::'
         else:
             std_namespace = str()
 
-        result = [self.generate_handler_decl(options, interface, impl=True) + ' {']
-        body = list()
-        body.append('auto& handler = ' + options.proxy + '::user_data_to_wrapper_cast<' + mangle_interface_name(interface.name, options) + '>(data)->_' + self .name + '_handler;')
-        body.append('if(handler) {')
+        result = list()
         for argument in self.arguments:
             if argument.argument_type == 'new_id' and argument.allow_null:
-                new_id_var = mangle_interface_name(argument.interface, options) + ' ' + argument.name + '_new_id(' + mangle_argument_name(argument.name) + ');'
-                body.append([new_id_var])
+                class_name = mangle_interface_name(argument.interface, options)
+                result.append(class_name + ' ' + argument.name + '_new_id = ' + options.proxy + '::wrap<' + class_name + '>(data, ' + mangle_argument_name(argument.name) + ');')
             elif argument.argument_type == 'string' and argument.allow_null:
-                string_var = std_namespace + 'string ' + argument.name + '_str = ' + mangle_argument_name(argument.name) + ' ? ' + mangle_argument_name(argument.name) + ' : ' + std_namespace + 'string();'
-                body.append([string_var])
+                if len(options.string_ref) > 0:
+                    string_type = options.string_ref
+                else:
+                    string_type = std_namespace + 'string'
+                result.append(string_type + ' ' + argument.name + '_str = ' + mangle_argument_name(argument.name) + ' ? ' + mangle_argument_name(argument.name) + ' : ' + string_type + '();')
+            elif argument.argument_type == 'array' and argument.allow_null and argument.has_array_view(options):
+                view_type = argument.generate_array_view_type(options)
+                result.append(view_type + ' ' + argument.name + '_view = ' + mangle_argument_name(argument.name) + ' ? ' + view_type + '(*' + mangle_argument_name(argument.name) + ') : ' + view_type + '();')
+        return result
 
-        handler_call = 'handler('
+    def generate_handler_call_arguments(self, options):
+        result = str()
         for argument in self.arguments:
             if argument.argument_type == 'object':
                 if not argument.allow_null:
-                    handler_call += '*'
-                handler_call += options.proxy + '::wrapper_cast<'
+                    result += '*'
+                result += options.proxy + '::wrapper_cast<'
                 if argument.interface is None:
-                    handler_call += options.proxy
+                    result += options.proxy
                 else:
-                    handler_call += mangle_interface_name(argument.interface, options)
-                handler_call += '>(' + mangle_argument_name(argument.name) + ')'
+                    result += mangle_interface_name(argument.interface, options)
+                result += '>(data, ' + mangle_argument_name(argument.name) + ')'
             elif argument.argument_type == 'new_id':
                 if argument.allow_null:
-                    handler_call += mangle_argument_name(argument.name) + ' ? &' + argument.name + '_new_id : nullptr'
+                    result += mangle_argument_name(argument.name) + ' ? &' + argument.name + '_new_id : nullptr'
                 else:
-                    handler_call += mangle_interface_name(argument.interface, options) + '(' + mangle_argument_name(argument.name) + ')'
+                    result += options.proxy + '::wrap<' + mangle_interface_name(argument.interface, options) + '>(data, ' + mangle_argument_name(argument.name) + ')'
             elif argument.argument_type == 'string' and argument.allow_null:
-                handler_call += mangle_argument_name(argument.name) + ' ? &' + argument.name + '_str' + ' : nullptr'
+                result += mangle_argument_name(argument.name) + ' ? &' + argument.name + '_str' + ' : nullptr'
+            elif argument.argument_type == 'array' and argument.has_array_view(options):
+                if argument.allow_null:
+                    result += mangle_argument_name(argument.name) + ' ? &' + argument.name + '_view : nullptr'
+                else:
+                    result += argument.generate_array_view_type(options) + '(*' + mangle_argument_name(argument.name) + ')'
             elif argument.argument_type == 'array' and not argument.allow_null:
-                handler_call += '*' + mangle_argument_name(argument.name)
+                result += '*' + mangle_argument_name(argument.name)
             else:
-                handler_call += mangle_argument_name(argument.name)
+                result += mangle_argument_name(argument.name)
             if argument != self.arguments[-1]:
-                handler_call += ', '
-        handler_call += ');'
-        body.append([handler_call])
+                result += ', '
+        return result
+
+    def generate_handler(self, options, interface):
+        result = [self.generate_handler_decl(options, interface, impl=True) + ' {']
+        body = list()
+        wrapper = options.proxy + '::user_data_to_wrapper_cast<' + mangle_interface_name(interface.name, options) + '>(data)'
+        if self.has_inline_handler(options, interface):
+            body.append('auto& handler = ' + wrapper + '->_' + self .name + '_handler;')
+            body.append('if(handler) {')
+            handler = 'handler'
+        else:
+            body.append('auto* handlers = ' + wrapper + '->_handlers.get();')
+            body.append('if(handlers && handlers->_' + self.name + '_handler) {')
+            handler = 'handlers->_' + self.name + '_handler'
+        body.append(self.generate_handler_locals(options))
+        body.append([handler + '(' + self.generate_handler_call_arguments(options) + ');'])
         body.append('}')
         result.append(body)
         result.append('}')
         return result
 
-    def generate_types_array(self, options, interface):
-        result = 'static const wl_interface* ' + interface.name + '_event_' + self.name + '_types[] = { '
+    def generate_dispatch_call(self, options):
+        result = self.name + '_handler(data, wl_obj'
+        for index, argument in enumerate(self.arguments):
+            result += ', ' + argument.generate_dispatch_argument(index)
+        result += ');'
+        return result
+
+    def generate_static_hook(self, options):
+        result = [
+            '/** \\brief Default handler for the ' + self.name + ' event, which does nothing',
+            ' *  @see ' + self.name + '_handler_sig',
+            ' */'
+        ]
+        hook = 'void on_' + self.name + '('
+        for argument in self.arguments:
+            hook += argument.generate_event_parameter(options)
+            if argument != self.arguments[-1]:
+                hook += ', '
+        hook += ') {'
+        result.append(hook)
+        result.append('}')
+        return result
+
+    def generate_static_handler(self, options, interface):
+        result = [self.generate_handler_decl(options, interface, impl=False) + ' {']
+        body = self.generate_handler_locals(options)
+        body.append(options.proxy + '::user_data_to_wrapper_cast<Derived>(data)->on_' + self.name + '(' + self.generate_handler_call_arguments(options) + ');')
+        result.append(body)
+        result.append('}')
+        return result
+
+    def generate_types(self, options):
+        result = list()
         for argument in self.arguments:
             if (argument.interface is not None) and (argument.argument_type == 'new_id' or argument.argument_type == 'object'):
-                result += '&' + mangle_interface_name(argument.interface, options) + '::interface'
+                result.append('&' + mangle_interface_name(argument.interface, options) + '::interface')
             else:
-                result += 'nullptr'
-
-            if argument != self.arguments[-1]:
-                result += ', '
-        if len(self.arguments) > 0:
-            result += ' '
-        result += '};'
+                result.append('nullptr')
         return result
 
-    def generate_wl_message(self, options, interface):
+    def generate_wl_message(self, options, message_types):
         result = '{ "' + self.name + '", "'
         if self.since > 1:
             result += str(self.since)
@@ -584,7 +789,7 @@ class Event:
                 result += 'h'
             elif argument.argument_type == 'new_id':
                 result += 'n'
-        result += '", ' + interface.name + '_event_' + self.name + '_types }'
+        result += '", ' + message_types.generate_reference(self.generate_types(options)) + ' }'
         return result
 
 class EnumEntry:
@@ -636,17 +841,19 @@ class Interface:
 
         opcode = 0
         for request in self.root.iter('request'):
-            new_request = Request(request, opcode)
+            new_request = Request(request, opcode, self.name)
             self.requests.append(new_request)
             if new_request.is_destructor:
                 if self.destructor is not None:
                     raise ProtocolError('There is more than one destructor in ' + self.name + '. wlcppgen assumes that at most one destructor exists.')
+                if len(new_request.arguments) > 0:
+                    raise ProtocolError('The destructor ' + self.name + '.' + new_request.name + ' has arguments. wlcppgen sends destructors without arguments.')
                 self.destructor = new_request
             opcode += 1
 
         event_index = 0
         for event in self.root.iter('event'):
-            self.events.append(Event(event, event_index))
+            self.events.append(Event(event, event_index, self.name))
             event_index += 1
 
         for enum in self.root.iter('enum'):
@@ -691,7 +898,7 @@ class Interface:
         result = str()
         if impl:
             result += mangle_interface_name(self.name, options) + '::'
-        else:
+        elif not options.proxy_base:
             result += 'virtual '
         result += '~' + mangle_interface_name(self.name, options) + '()'
         return result
@@ -747,21 +954,36 @@ class Interface:
         if impl:
             result += mangle_interface_name(self.name, options) + '::'
         result += 'destroy()'
-        if not impl:
+        if not impl and not options.proxy_base:
             result += ' override'
         return result
 
+    def generate_base_class(self, options):
+        # With --proxy-base the class derives from a CRTP base, which calls
+        # destroy() of the class directly instead of through the vtable.
+        if options.proxy_base:
+            return options.proxy_base + '<' + mangle_interface_name(self.name, options) + '>'
+        return options.proxy
+
     def generate_version_define(self, options):
         return '#define ' + options.macro_prefix + mangle_interface_name(self.name, options).upper() + '_VERSION ' + str(self.version)
 
+    def has_static_handlers(self, options):
+        return options.handler_model == 'static' and not options.ignore_events and len(self.events) > 0
+
     def generate_class(self, options):
         class_name = mangle_interface_name(self.name, options)
+        static_handlers = self.has_static_handlers(options)
 
         result = list()
         result.extend(self.description.generate(options))
+        if static_handlers:
+            class_head = 'class ' + class_name
+        else:
+            class_head = 'class ' + class_name + ' final'
         result.extend([
-            'class ' + class_name + ' final',
-            [': public ' + options.proxy + ' {'],
+            class_head,
+            [': public ' + self.generate_base_class(options) + ' {'],
             'public:'
         ])
 
@@ -782,6 +1004,17 @@ class Interface:
             'static constexpr ' + std_namespace + 'uint32_t version = ' + str(self.version) + ';'
         ])
 
+        if self.destructor is None:
+            destructor_opcode = -1
+        else:
+            destructor_opcode = self.destructor.opcode
+
+        public_part.extend([
+            '',
+            '/** \\brief Opcode of the destructor request of @ref ' + class_name + ', -1 if there is none */',
+            'static constexpr ' + std_namespace + 'int32_t destructor_opcode = ' + str(destructor_opcode) + ';'
+        ])
+
         public_part.extend([
             '',
             '/** \\brief Wrap existing ' + self.name + ' object',
@@ -831,26 +1064,36 @@ class Interface:
                     public_part.extend(request.generate_impl(options))
                 else:
                     public_part.extend(request.generate_decl(options))
+                if options.request_args and request.has_args_struct():
+                    public_part.append('')
+                    public_part.extend(request.generate_args_struct(options))
 
         if not options.ignore_events:
             for event in self.events:
                 public_part.append('')
                 public_part.extend(event.generate_handler_sig(options))
-                public_part.append('')
-                public_part.extend(event.generate_set_handler_method(options))
+                if not static_handlers:
+                    public_part.append('')
+                    public_part.extend(event.generate_set_handler_method(options, self))
 
         result.append(public_part)
 
-        if self.destructor is not None:
+        if self.destructor is not None or static_handlers:
             result.append('')
             result.append('protected:')
-            protected_part = [
-                self.generate_destroy_method(options, impl=False) + ';'
-            ]
+            protected_part = list()
+            if self.destructor is not None:
+                protected_part.append(self.generate_destroy_method(options, impl=False) + ';')
+                if options.proxy_base:
+                    protected_part.append('friend class ' + self.generate_base_class(options) + ';')
+            if static_handlers:
+                if self.destructor is not None:
+                    protected_part.append('')
+                protected_part.extend(self.generate_listener_t(options))
 
             result.append(protected_part)
 
-        if not options.ignore_events and len(self.events) > 0:
+        if not options.ignore_events and len(self.events) > 0 and not static_handlers:
             result.append('')
             result.append('private:')
             private_part = list()
@@ -863,15 +1106,190 @@ class Interface:
             private_part.append('')
             private_part.append(self.generate_listener(options, impl=False) + ';')
 
+            if options.dispatcher:
+                private_part.append('')
+                private_part.append(self.generate_dispatcher_decl(options, impl=False) + ';')
+
+            sparse_events = self.sparse_events(options)
+            if len(sparse_events) > 0:
+                private_part.append('')
+                private_part.extend(self.generate_handlers_t(options, sparse_events))
+
             private_part.append('')
+            if len(sparse_events) > 0:
+                private_part.append(std_namespace + 'unique_ptr<handlers_t> _handlers;')
             for event in self.events:
-                private_part.append(event.generate_function_member(options))
+                if event not in sparse_events:
+                    private_part.append(event.generate_function_member(options))
 
             result.append(private_part)
 
         result.append('};')
         return result
 
+    def generate_add_listener(self, options):
+        if options.dispatcher:
+            return 'add_dispatcher(&dispatcher, listener);'
+        else:
+            return 'add_listener(listener);'
+
+    def generate_dispatcher_decl(self, options, impl):
+        if options.qualify_std_namespace:
+            std_namespace = 'std::'
+        else:
+            std_namespace = str()
+
+        result = str()
+        if not impl:
+            result += 'static '
+        result += 'int '
+        if impl:
+            result += mangle_interface_name(self.name, options) + '::'
+        result += 'dispatcher(const void* implementation, void* target, ' + std_namespace + 'uint32_t opcode, const wl_message* message, wl_argument* args)'
+        return result
+
+    def generate_dispatcher(self, options, impl):
+        """Generate the dispatcher, which unpacks the arguments of an event and calls
+        its handler directly instead of libwayland calling the listener through
+        libffi."""
+        result = [self.generate_dispatcher_decl(options, impl) + ' {']
+        body = [
+            'wl_proxy* wl_obj = static_cast<wl_proxy*>(target);',
+            'void* data = wl_proxy_get_user_data(wl_obj);',
+            'switch(opcode) {'
+        ]
+        for event in self.events:
+            body.append('case ' + str(event.index) + ':')
+            body.append([event.generate_dispatch_call(options), 'break;'])
+        body.extend([
+            '}',
+            'return 0;'
+        ])
+        result.append(body)
+        result.append('}')
+        return result
+
+    def sparse_events(self, options):
+        result = list()
+        for event in self.events:
+            if not event.has_inline_handler(options, self):
+                result.append(event)
+        return result
+
+    def generate_handlers_t(self, options, sparse_events):
+        if options.qualify_std_namespace:
+            std_namespace = 'std::'
+        else:
+            std_namespace = str()
+
+        result = ['struct handlers_t {']
+        members = list()
+        for event in sparse_events:
+            members.append(event.generate_function_member(options))
+        result.append(members)
+        result.extend([
+            '};',
+            '',
+            'handlers_t& handlers() {', [
+                'if(!_handlers) {', [
+                    '_handlers.reset(new handlers_t());'
+                ],
+                '}',
+                'return *_handlers;'
+            ],
+            '}'
+        ])
+        return result
+
+    def generate_static_class(self, options):
+        class_name = mangle_interface_name(self.name, options)
+        static_class_name = 'basic_' + class_name
+
+        if options.qualify_std_namespace:
+            std_namespace = 'std::'
+        else:
+            std_namespace = str()
+
+        result = [
+            '/** \\brief @ref ' + class_name + ' with statically dispatched event handlers',
+            ' *',
+            ' *  Derived has to inherit from ' + static_class_name + '<Derived>. Events are passed to the',
+            ' *  member functions on_<event>() of Derived, which are called directly and can be',
+            ' *  inlined. Events for which Derived does not declare a member function are ignored.',
+            ' */',
+            'template <typename Derived>',
+            'class ' + static_class_name,
+            [': public ' + class_name + ' {'],
+            'public:'
+        ]
+
+        public_part = [
+            '/** \\brief Wrap existing ' + self.name + ' object',
+            ' *  @param obj Existing native object to wrap, can be nullptr',
+            ' *  @param managed true, if the new wrapper object owns the ' + self.name + ' object and is responsible for destryoing it',
+            ' */',
+            static_class_name + '(wl_proxy* obj = nullptr, bool managed = true)', [
+                ': ' + class_name + '(obj, managed) {',
+                self.generate_add_listener(options)
+            ],
+            '}',
+            '',
+            '/** \\brief Create new @ref ' + static_class_name + ' from factory',
+            ' *  @param factory Object which acts as the factory',
+            ' */',
+            'explicit ' + static_class_name + '(' + options.proxy + '& factory)', [
+                ': ' + class_name + '(factory) {',
+                self.generate_add_listener(options)
+            ],
+            '}',
+            '',
+            '/** \\brief Take over a @ref ' + class_name + ' object, e.g. one returned by a request',
+            ' *  @param rhs Object to take over',
+            ' */',
+            static_class_name + '(' + class_name + '&& rhs)', [
+                ': ' + class_name + '(' + std_namespace + 'move(rhs)) {',
+                self.generate_add_listener(options)
+            ],
+            '}',
+            '',
+            '/** \\brief Default move constructor */',
+            static_class_name + '(' + static_class_name + '&& rhs) = default;',
+            '',
+            '/** \\brief Default move assignment operator */',
+            static_class_name + '& operator=(' + static_class_name + '&& rhs) = default;'
+        ]
+
+        for event in self.events:
+            public_part.append('')
+            public_part.extend(event.generate_static_hook(options))
+
+        result.append(public_part)
+        result.append('')
+        result.append('private:')
+
+        private_part = list()
+        for event in self.events:
+            private_part.extend(event.generate_static_handler(options, self))
+            private_part.append('')
+        private_part.append(self.generate_listener(options, impl=False) + ';')
+
+        if options.dispatcher:
+            private_part.append('')
+            private_part.extend(self.generate_dispatcher(options, impl=False))
+
+        result.append(private_part)
+        result.append('};')
+        result.append('')
+
+        result.append('template <typename Derived>')
+        result.append('const typename ' + static_class_name + '<Derived>::listener_t ' + static_class_name + '<Derived>::listener = {')
+        handlers = list()
+        for event in self.events:
+            handlers.append('&' + event.name + '_handler,')
+        result.append(handlers)
+        result.append('};')
+        return result
+
     def generate_enums(self, options):
         result = list()
         for enum in self.enums:
@@ -880,37 +1298,31 @@ class Interface:
                 result.append('')
         return result
 
-    def generate_requests_message_array(self, options):
-        result = ['static const wl_message ' + self.name + '_requests[] = {']
+    def generate_requests_message_array(self, options, message_types):
+        result = ['static constexpr wl_message ' + self.name + '_requests[] = {']
         for request in self.requests:
-            result.append([request.generate_wl_message(options, self) + ','])
+            result.append([request.generate_wl_message(options, message_types) + ','])
         result.append('};')
         return result
 
-    def generate_events_message_array(self, options):
-        result = ['static const wl_message ' + self.name + '_events[] = {']
+    def generate_events_message_array(self, options, message_types):
+        result = ['static constexpr wl_message ' + self.name + '_events[] = {']
         for event in self.events:
-            result.append([event.generate_wl_message(options, self) + ','])
+            result.append([event.generate_wl_message(options, message_types) + ','])
         result.append('};')
         return result
 
-    def generate_interface(self, options):
+    def generate_interface(self, options, message_types):
         result = list()
         if len(self.requests) > 0:
-            for request in self.requests:
-                result.append(request.generate_types_array(options, self))
-            result.append('')
-            result.extend(self.generate_requests_message_array(options))
+            result.extend(self.generate_requests_message_array(options, message_types))
             result.append('')
             requests = self.name + '_requests'
         else:
             requests = 'nullptr'
 
         if len(self.events) > 0:
-            for event in self.events:
-                result.append(event.generate_types_array(options, self))
-            result.append('')
-            result.extend(self.generate_events_message_array(options))
+            result.extend(self.generate_events_message_array(options, message_types))
             result.append('')
             events = self.name + '_events'
         else:
@@ -927,14 +1339,15 @@ class Interface:
 
         return result
 
-    def generate_cpp(self, options):
+    def generate_cpp(self, options, message_types):
         result = list()
         class_name = mangle_interface_name(self.name, options)
         have_events = len(self.events) > 0
 
-        result.extend(self.generate_interface(options))
+        result.extend(self.generate_interface(options, message_types))
 
-        if not options.ignore_events and have_events:
+        dynamic_handlers = not options.ignore_events and have_events and options.handler_model != 'static'
+        if dynamic_handlers:
             result.append('')
             result.append(self.generate_listener(options, impl=True) + ' = {')
             handlers = list()
@@ -943,29 +1356,33 @@ class Interface:
             result.append(handlers)
             result.append('};')
 
+            if options.dispatcher:
+                result.append('')
+                result.extend(self.generate_dispatcher(options, impl=True))
+
         result.append('')
         result.append(self.generate_wl_obj_ctor(options, impl=True))
         wl_obj_ctor = list()
-        if not options.ignore_events and have_events:
+        if dynamic_handlers:
             wl_obj_ctor.extend([
-                ': ' + options.proxy + '(obj, managed) {',
-                'add_listener(listener);'
+                ': ' + self.generate_base_class(options) + '(obj, managed) {',
+                self.generate_add_listener(options)
             ])
         else:
-            wl_obj_ctor.append(': ' + options.proxy + '(obj, managed) {')
+            wl_obj_ctor.append(': ' + self.generate_base_class(options) + '(obj, managed) {')
         result.append(wl_obj_ctor)
         result.append('}')
 
         result.append('')
         result.append(self.generate_factory_ctor(options, impl=True))
         factory_ctor = list()
-        if not options.ignore_events and have_events:
+        if dynamic_handlers:
             factory_ctor.extend([
-                ': ' + options.proxy + '(factory, interface) {',
-                'add_listener(listener);'
+                ': ' + self.generate_base_class(options) + '(factory, interface) {',
+                self.generate_add_listener(options)
             ])
         else:
-            factory_ctor.append(': ' + options.proxy + '(factory, interface) {')
+            factory_ctor.append(': ' + self.generate_base_class(options) + '(factory, interface) {')
         result.append(factory_ctor)
         result.append('}')
 
@@ -988,7 +1405,7 @@ class Interface:
             result.extend([
                 self.generate_destroy_method(options, impl=True) + ' {', [
                     'if(valid() && managed()) {', [
-                        'marshal(' + str(self.destructor.opcode) + ');'
+                        'marshal_array(' + str(self.destructor.opcode) + ', nullptr, interface.methods[' + str(self.destructor.opcode) + ']);'
                     ],
                     '}',
                     options.proxy + '::destroy();'
@@ -996,7 +1413,7 @@ class Interface:
                 '}'
             ])
 
-        if not options.ignore_events:
+        if dynamic_handlers:
             for event in self.events:
                 result.append('')
                 result.extend(event.generate_handler(options, self))
@@ -1018,7 +1435,32 @@ class Specification:
         for interface in self.root.iter('interface'):
             self.interfaces.append(Interface(interface))
 
-    def generate(self, hook, options):
+    def interface_hashes(self, options, templates):
+        """Return a dict which maps interface names to a hash of everything their
+        generated code depends on: the interface's XML, the names of the
+        interfaces it requires, the specification's name and copyright, the
+        options, the templates and the generator itself."""
+        common = hashlib.sha256()
+        common.update(repr(wlcppgen_version).encode('utf-8'))
+        with open(os.path.abspath(__file__), 'rb') as f:
+            common.update(f.read())
+        common.update(json.dumps(vars(options), sort_keys=True).encode('utf-8'))
+        for template in templates:
+            if template is not None:
+                common.update(template.template_str.encode('utf-8'))
+        common.update(self.name.encode('utf-8'))
+        if self.copyright is not None:
+            common.update(self.copyright.encode('utf-8'))
+
+        result = dict()
+        for interface in self.interfaces:
+            interface_hash = common.copy()
+            interface_hash.update(xml.etree.ElementTree.tostring(interface.root))
+            interface_hash.update(repr(sorted(interface.required_interfaces(options))).encode('utf-8'))
+            result[interface.name] = interface_hash.hexdigest()
+        return result
+
+    def generate(self, hook, options, message_types=None):
         if hook.id_str == 'spec.hpp.prototypes':
             return self.generate_prototypes(options)
         elif hook.id_str == 'spec.hpp.required_prototypes':
@@ -1026,7 +1468,13 @@ class Specification:
         elif hook.id_str == 'spec.hpp.classes':
             return self.generate_classes(options)
         elif hook.id_str == 'spec.cpp':
-            return self.generate_cpp(options)
+            return self.generate_cpp(options, message_types)
+        elif hook.id_str == 'spec.hpp.interface_table':
+            return self.interface_table(options).generate_header(options)
+        elif hook.id_str == 'spec.cpp.interface_table':
+            return self.interface_table(options).generate_impl(options)
+        elif hook.id_str == 'spec.fwd':
+            return self.generate_forward(options)
         elif hook.id_str == 'spec.copyright':
             return self.generate_copyright(options)
         else:
@@ -1054,27 +1502,36 @@ class Specification:
             result.append(Interface.generate_prototype(interface, options))
         return result
 
+    def interface_table(self, options):
+        return InterfaceTable(filter_interfaces(self.interfaces, options), identifier(self.name) + '_')
+
     def generate_classes(self, options):
-        filtered_interfaces = filter_interfaces(self.interfaces, options)
+        result = generate_classes(filter_interfaces(self.interfaces, options), options)
+        if options.interface_table:
+            result.append('')
+            result.extend(self.interface_table(options).generate_decl(options))
+        return result
+
+    def generate_forward(self, options):
+        """Generate prototypes, version macros and enums of every interface. The
+        options --only and --exclude are ignored, because the forward header is
+        shared by all classes of the specification."""
         result = list()
-        for interface in filtered_interfaces:
-            result.append(interface.generate_version_define(options))
+        for interface in self.interfaces:
+            result.append(Interface.generate_prototype(interface.name, options))
+        for interface in self.interfaces:
             result.append('')
-            result.extend(interface.generate_enums(options))
+            result.append(interface.generate_version_define(options))
             if len(interface.enums) > 0:
                 result.append('')
-            result.extend(interface.generate_class(options))
-            if interface != filtered_interfaces[-1]:
-                result.append('')
+                result.extend(interface.generate_enums(options))
         return result
 
-    def generate_cpp(self, options):
-        filtered_interfaces = filter_interfaces(self.interfaces, options)
-        result = list()
-        for interface in filtered_interfaces:
-            result.extend(interface.generate_cpp(options))
-            if interface != filtered_interfaces[-1]:
-                result.append('')
+    def generate_cpp(self, options, message_types):
+        result = generate_cpp(filter_interfaces(self.interfaces, options), options, message_types)
+        if options.interface_table:
+            result.append('')
+            result.extend(self.interface_table(options).generate_impl(options))
         return result
 
     def generate_copyright(self, options):
@@ -1093,6 +1550,239 @@ class Specification:
         result.append(' */')
         return result
 
+class MessageTypes:
+    """Pool of the wl_message types arrays of every interface which is generated.
+
+    All messages share one array. Messages whose arguments have no interface
+    point to the leading run of nullptr entries, like wayland-scanner does. A
+    type list which already occurs in the array is not stored again.
+    """
+    def __init__(self, specs, options):
+        messages = list()
+        for spec in specs:
+            for interface in filter_interfaces(spec.interfaces, options):
+                messages.extend(interface.requests)
+                messages.extend(interface.events)
+
+        self.null_count = 1
+        for message in messages:
+            types = message.generate_types(options)
+            if types.count('nullptr') == len(types):
+                self.null_count = max(self.null_count, len(types))
+
+        self.types = ['nullptr'] * self.null_count
+        self.offsets = dict()
+        for message in messages:
+            types = message.generate_types(options)
+            if tuple(types) not in self.offsets:
+                self.offsets[tuple(types)] = self.find(types)
+
+    def find(self, types):
+        for offset in range(len(self.types) - len(types) + 1):
+            if self.types[offset:offset + len(types)] == types:
+                return offset
+        self.types.extend(types)
+        return len(self.types) - len(types)
+
+    def generate_reference(self, types):
+        return 'message_types + ' + str(self.offsets[tuple(types)])
+
+    def generate(self, options):
+        entries = list()
+        for interface_type in self.types:
+            entries.append(interface_type + ',')
+        return ['static const wl_interface* message_types[] = {', entries, '};']
+
+def generate_classes(interfaces, options):
+    result = list()
+    for interface in interfaces:
+        if len(options.forward_header) == 0:
+            result.append(interface.generate_version_define(options))
+            result.append('')
+            result.extend(interface.generate_enums(options))
+            if len(interface.enums) > 0:
+                result.append('')
+        result.extend(interface.generate_class(options))
+        if interface.has_static_handlers(options):
+            result.append('')
+            result.extend(interface.generate_static_class(options))
+        if interface != interfaces[-1]:
+            result.append('')
+    return result
+
+def generate_cpp(interfaces, options, message_types):
+    result = list()
+    for interface in interfaces:
+        result.extend(interface.generate_cpp(options, message_types))
+        if interface != interfaces[-1]:
+            result.append('')
+    return result
+
+def identifier(name):
+    return ''.join(c if c.isalnum() else '_' for c in name)
+
+def fnv1a(data, seed):
+    result = seed
+    for byte in bytearray(data):
+        result = ((result ^ byte) * 16777619) & 0xffffffff
+    return result
+
+class InterfaceTable:
+    """Perfect hash table which maps interface names to generated classes.
+
+    Names are hashed with 32 bit FNV-1a, whose offset basis is used as seed.
+    The generator searches the smallest power of two as table size and a seed
+    for which no two names share a slot, so a lookup costs one hash and one
+    comparison of the name in the slot.
+    """
+    fnv_offset_basis = 2166136261
+    max_seeds = 1024
+
+    def __init__(self, interfaces, prefix):
+        self.interfaces = interfaces
+        self.function = 'find_' + prefix + 'interface'
+        self.table = prefix + 'interface_table'
+
+        names = [interface.name.encode('utf-8') for interface in interfaces]
+        self.size = 1
+        while self.size < len(names):
+            self.size *= 2
+        self.seed = None
+        while self.seed is None:
+            for seed in range(self.fnv_offset_basis, self.fnv_offset_basis + self.max_seeds):
+                if len(set(self.slot(name, seed) for name in names)) == len(names):
+                    self.seed = seed
+                    break
+            else:
+                self.size *= 2
+
+    def slot(self, name, seed):
+        return fnv1a(name, seed) & (self.size - 1)
+
+    def parameters(self, options):
+        """Without --string-ref, the name is passed as pointer and size."""
+        if len(options.string_ref) > 0:
+            return options.string_ref + ' name'
+        return 'const char* name, std::size_t name_size'
+
+    def generate_decl(self, options):
+        return [
+            '/** \\brief Generated class of the interface with the given name or nullptr */',
+            'const interface_info* ' + self.function + '(' + self.parameters(options) + ');'
+        ]
+
+    def generate_header(self, options):
+        """Declaration for a header of its own, which does not require the
+        definition of interface_info."""
+        return ['struct interface_info;', ''] + self.generate_decl(options)
+
+    def generate_impl(self, options):
+        slots = [None] * self.size
+        for interface in self.interfaces:
+            slots[self.slot(interface.name.encode('utf-8'), self.seed)] = interface
+
+        entries = list()
+        for interface in slots:
+            if interface is None:
+                entries.append('{},')
+                continue
+            class_name = mangle_interface_name(interface.name, options)
+            entries.append('{ "' + interface.name + '", ' + str(len(interface.name.encode('utf-8'))) +
+                           ', &' + class_name + '::interface, ' + class_name + '::version, ' +
+                           '&interface_info::create_wrapper<' + class_name + '>, ' +
+                           '&interface_info::destroy_wrapper<' + class_name + '> },')
+
+        namespace = ''
+        if len(options.namespace) > 0:
+            namespace = options.namespace + '::'
+
+        if len(options.string_ref) > 0:
+            lookup = [
+                'std::uint32_t hash = ' + '0x%08x' % self.seed + ';',
+                'for(std::size_t i = 0; i < name.size(); ++i) {',
+                ['hash = (hash ^ static_cast<unsigned char>(name.data()[i])) * 16777619;'],
+                '}',
+                '',
+                'const interface_info& info = ' + self.table + '[hash & ' + str(self.size - 1) + '];',
+                'if(info.interface == nullptr || ' + options.string_ref + '(info.name, info.name_size) != name) {',
+                ['return nullptr;'],
+                '}',
+                'return &info;'
+            ]
+        else:
+            lookup = [
+                'std::uint32_t hash = ' + '0x%08x' % self.seed + ';',
+                'for(std::size_t i = 0; i < name_size; ++i) {',
+                ['hash = (hash ^ static_cast<unsigned char>(name[i])) * 16777619;'],
+                '}',
+                '',
+                'const interface_info& info = ' + self.table + '[hash & ' + str(self.size - 1) + '];',
+                'if(info.interface == nullptr || info.name_size != name_size) {',
+                ['return nullptr;'],
+                '}',
+                'for(std::size_t i = 0; i < name_size; ++i) {',
+                [
+                    'if(info.name[i] != name[i]) {',
+                    ['return nullptr;'],
+                    '}'
+                ],
+                '}',
+                'return &info;'
+            ]
+
+        return [
+            'static const interface_info ' + self.table + '[' + str(self.size) + '] = {',
+            entries,
+            '};',
+            '',
+            'const interface_info* ' + namespace + self.function + '(' + self.parameters(options) + ') {',
+            lookup,
+            '}'
+        ]
+
+class Amalgamation:
+    """Interfaces of all specifications in one header and one source file.
+
+    Interfaces are ordered such that required interfaces are defined first.
+    Prototypes are only needed for interfaces which are required before their
+    definition, which only happens for cyclic dependencies, or which are not
+    generated at all.
+    """
+    def __init__(self, specs, options):
+        interfaces = dict()
+        for spec in specs:
+            for interface in filter_interfaces(spec.interfaces, options):
+                interfaces[interface.name] = interface
+
+        self.interfaces = list()
+        visited = set()
+        for spec in specs:
+            for interface in filter_interfaces(spec.interfaces, options):
+                self.visit(interface, interfaces, visited, options)
+
+        self.prototypes = set()
+        defined = set()
+        for interface in self.interfaces:
+            for required in interface.required_interfaces(options):
+                if required not in defined:
+                    self.prototypes.add(required)
+            defined.add(interface.name)
+
+    def visit(self, interface, interfaces, visited, options):
+        if interface.name in visited:
+            return
+        visited.add(interface.name)
+        for required in sorted(interface.required_interfaces(options)):
+            if required in interfaces:
+                self.visit(interfaces[required], interfaces, visited, options)
+        self.interfaces.append(interface)
+
+    def generate_prototypes(self, options):
+        result = list()
+        for name in sorted(self.prototypes):
+            result.append(Interface.generate_prototype(name, options))
+        return result
+
 class Hook:
     def __init__(self, hook_str):
         self.hook_str = hook_str
@@ -1159,11 +1849,30 @@ class HookHandlerInclude:
 
         if target == 'self':
             return ['#include ' + variant[0] + substitute(options.header, options) + variant[1]]
+        elif target == 'forward':
+            result = list()
+            if len(options.forward_header) > 0:
+                for spec in specs:
+                    result.append('#include ' + variant[0] + forward_header(spec, options) + variant[1])
+            return result
         elif target == 'extra':
             result = list()
             for include in options.extra_includes:
                 result.append('#include ' + variant[0] + include + variant[1])
             return result
+        elif target == 'interface_table':
+            result = list()
+            for spec in specs:
+                result.append('#include ' + variant[0] + interface_table_header(spec) + variant[1])
+            return result
+        elif target == 'interfaces':
+            result = list()
+            for spec in specs:
+                for interface in filter_interfaces(spec.interfaces, options):
+                    interface_options = copy.copy(options)
+                    interface_options.only = [interface.name]
+                    result.append('#include ' + variant[0] + substitute(options.header, interface_options) + variant[1])
+            return result
         elif target == 'required_headers':
             if single_interface_mode(options):
                 for spec in specs:
@@ -1186,29 +1895,87 @@ class HookHandlerSpec:
 
     def generate(self, hook, specs, options):
         result = list()
+        message_types = None
+        if hook.id_str == 'spec.cpp':
+            message_types = MessageTypes(specs, options)
+            result.extend(message_types.generate(options))
+            result.append('')
+
+        if len(options.forward_header) > 0 and hook.id_str in ['spec.hpp.prototypes', 'spec.hpp.required_prototypes']:
+            # Interfaces of the given specifications are declared by their forward
+            # headers, so only interfaces of other specifications are left.
+            declared = set()
+            required = set()
+            for spec in specs:
+                for interface in spec.interfaces:
+                    declared.add(interface.name)
+                required.update(spec.required_interfaces(options))
+            for name in sorted(required - declared):
+                result.append(Interface.generate_prototype(name, options))
+            return result
+
+        if options.amalgamate:
+            if hook.id_str in ['spec.hpp.prototypes', 'spec.hpp.required_prototypes']:
+                return Amalgamation(specs, options).generate_prototypes(options)
+            elif hook.id_str == 'spec.hpp.classes':
+                interfaces = Amalgamation(specs, options).interfaces
+                result = generate_classes(interfaces, options)
+                if options.interface_table:
+                    result.append('')
+                    result.extend(InterfaceTable(interfaces, '').generate_decl(options))
+                return result
+            elif hook.id_str == 'spec.cpp':
+                interfaces = Amalgamation(specs, options).interfaces
+                result.extend(generate_cpp(interfaces, options, message_types))
+                if options.interface_table:
+                    result.append('')
+                    result.extend(InterfaceTable(interfaces, '').generate_impl(options))
+                return result
+            elif hook.id_str == 'spec.hpp.interface_table':
+                return InterfaceTable(Amalgamation(specs, options).interfaces, '').generate_header(options)
+            elif hook.id_str == 'spec.cpp.interface_table':
+                return InterfaceTable(Amalgamation(specs, options).interfaces, '').generate_impl(options)
+
         for spec in specs:
-            result.extend(spec.generate(hook, options))
+            result.extend(spec.generate(hook, options, message_types))
             if spec is not specs[-1]:
                 result.append('')
         return result
 
 class GeneratorOptions:
     def __init__(self):
+        self.amalgamate = False
+        self.array_types = {
+            'wl_keyboard.enter.keys': 'uint',
+            'xdg_toplevel.configure.states': 'uint',
+            'zxdg_toplevel_v6.configure.states': 'uint'
+        }
+        self.array_view = 'array_view'
+        self.dispatcher = False
         self.exclude = list()
         self.extra_includes = list()
+        self.forward_header = ''
+        self.handler_model = 'function'
+        self.handler_storage = 'inline'
+        self.handler_type = None
         self.header = 'wlcpp.hpp'
         self.ignore_events = False
         self.include_guard = '_WLCPP_'
         self.indent = 4
         self.indent_tabs = False
+        self.inline_handlers = list()
         self.interface_prefix = ''
         self.interface_strip = ['wl_']
+        self.interface_table = False
         self.linewidth = 80
         self.macro_prefix = 'WLCPP_'
         self.namespace = 'wlcpp'
         self.only = list()
         self.proxy = 'proxy'
+        self.proxy_base = ''
         self.qualify_std_namespace = False
+        self.request_args = False
+        self.string_ref = 'string_ref'
 
 class SourceTemplate:
     def __init__(self, template_str):
@@ -1288,13 +2055,54 @@ def print_usage():
     print('  --version                    Display version.')
     print()
     print('Available options:')
+    print('  --amalgamate                 Generate all interfaces of all given protocols into one')
+    print('                               header and one source file. Classes are ordered such')
+    print('                               that required classes are defined first, so prototypes')
+    print('                               are only generated where they cannot be avoided.')
+    print('  --array-types                Comma-separated list of element types of array')
+    print('                               arguments (e.g. wl_keyboard.enter.keys:uint). The type')
+    print('                               is int, uint, fixed or a C++ type. Arrays with a known')
+    print('                               element type are passed as a typed array view.')
+    print('  --array-view (=array_view)   Class template which views typed arrays without')
+    print('                               copying them. If empty, wl_array is used instead.')
+    print('  --dispatcher                 Generate a dispatcher for every class with events, which')
+    print('                               is installed through wl_proxy_add_dispatcher. It calls')
+    print('                               the handlers directly instead of libwayland calling')
+    print('                               the listener through libffi. Requires add_dispatcher()')
+    print('                               in the proxy class.')
     print('  --dst                        Output filename.')
     print('                               If missing or "-" is given then stdout will be used.')
+    print('                               The file is not written if its content is unchanged.')
     print('  --exclude                    Comma-separated list of interfaces to exclude. This is')
     print('                               especially useful for wl_display, because a manually')
     print('                               written wrapper is more useful.')
     print('  --extra-includes             Comma-separated list of files for which include')
     print('                               directives are generated by the "include.extra" hook.')
+    print('  --forward-header             Filename of the forward header of each protocol, where')
+    print('                               "%s" is replaced with the protocol name (e.g.')
+    print('                               %s_fwd.hpp). The forward header declares all classes and')
+    print('                               contains the enums and version macros, which are then')
+    print('                               omitted from the class headers. It is included by the')
+    print('                               "include.forward" hook and generated from the')
+    print('                               "spec.fwd" hook.')
+    print('  --handler-model (=function)  How event handlers are dispatched:')
+    print('                               "function" - Handlers are set at runtime through')
+    print('                               set_*_handler and stored in std::function objects.')
+    print('                               "static" - Additionally generates a class template')
+    print('                               basic_<class><Derived> for every class with events,')
+    print('                               which calls the member functions on_<event>() of')
+    print('                               Derived directly.')
+    print('  --handler-storage (=inline)  Where handlers are stored when the handler model is')
+    print('                               "function":')
+    print('                               "inline" - Every object embeds one handler per event.')
+    print('                               "sparse" - Handlers are stored in a table which is')
+    print('                               allocated by the first call to set_*_handler.')
+    print('  --handler-type (=function)   Class template which stores event handlers when the')
+    print('                               handler model is "function". It must be constructible')
+    print('                               from any callable and provide operator bool and')
+    print('                               operator(). Defaults to std::function. The sample')
+    print('                               uses "delegate" from delegate.hpp, which never')
+    print('                               allocates.')
     print('  --header (=wlcpp.hpp)        Header filename which contains declarations of the')
     print('                               generated code.')
     print('                               Can be used for the "include.self" hook.')
@@ -1302,11 +2110,22 @@ def print_usage():
     print('  --include-guard (=_WLCPP_)   Name of the include guard.')
     print('  --indent (=4)                Number of spaces or tabs to indent.')
     print('  --indent-tabs                Indent using tabs instead of spaces.')
+    print('  --inline-handlers            Comma-separated list of events (e.g. wl_pointer.motion)')
+    print('                               whose handlers are embedded in the object even if the')
+    print('                               handler storage is "sparse".')
     print('  --interface-prefix           Prefix for generated class names. This options applies')
     print('                               after stripping.')
     print('  --interface-strip (=wl_)     Comma-separated list of prefixes to srtip from')
     print('                               interface names to generate class names. Only the first')
     print('                               prefix found is stripped.')
+    print('  --interface-table            Generate a perfect hash table which maps interface names')
+    print('                               to the generated classes, which is searched by')
+    print('                               find_<protocol>_interface(), or find_interface() with')
+    print('                               --amalgamate. With --output-dir, the table is written to')
+    print('                               <protocol>_interfaces.cpp and declared in')
+    print('                               <protocol>_interfaces.hpp, which only includes the')
+    print('                               --extra-includes. The name is passed as string_ref, or')
+    print('                               as const char* and size if --string-ref is empty.')
     print('  --linewidth (=80)            Maximum linewidth. Currently not very useful, because')
     print('                               it is only respected for comments and indentation is not')
     print('                               taken into account.')
@@ -1317,11 +2136,33 @@ def print_usage():
     print('                               for. This option takes precedence over --exclude.')
     print('                               Specifying exactly one interface activates single')
     print('                               interface mode. See below.')
+    print('  --output-dir                 Generate a header and a source file for every interface')
+    print('                               into the given directory at once. See "Output directory')
+    print('                               mode" below.')
     print('  --proxy (=proxy)             Name of the proxy class.')
+    print('  --proxy-base                 Class template which is used as the base class of every')
+    print('                               generated class instead of the proxy class (e.g.')
+    print('                               proxy_base). It is instantiated with the generated')
+    print('                               class, derives from the proxy class and calls its')
+    print('                               destroy() directly on move assignment. The generated')
+    print('                               destructor and destroy() are not virtual.')
     print('  --qualify-std-namespace      Prefix std types with "std::". Should be specified')
     print('                               when generating the header.')
+    print('  --request-args               Generate a POD struct <request>_args for every request')
+    print('                               whose arguments are integers, fixed point numbers or')
+    print('                               objects. It holds the arguments and packs them into')
+    print('                               wl_argument fields, e.g. for a request_queue.')
     print('  --src                        Source template filename.')
     print('                               If missing or "-" is given then stdin will be used.')
+    print('  --src-cpp                    Source template filename of source files in output')
+    print('                               directory mode.')
+    print('  --src-fwd                    Source template filename of forward headers in output')
+    print('                               directory mode.')
+    print('  --src-hpp                    Source template filename of header files in output')
+    print('                               directory mode.')
+    print('  --string-ref (=string_ref)   Non-owning string type of string event arguments (e.g.')
+    print('                               std::string_view). The event data is not copied.')
+    print('                               If empty, const std::string& is used instead.')
     print()
     print('Single interface mode:')
     print('  When exactly one interface is specified through "--only", single interface mode is')
@@ -1333,6 +2174,19 @@ def print_usage():
     print('   * Special identifiers can be used for the options "--header" and "--include-guard":')
     print('     "%c" - Class name')
     print('     "%C" - Uppercase class name')
+    print()
+    print('Output directory mode:')
+    print('  When "--output-dir" is given, every interface is generated in single interface mode')
+    print('  by one invocation:')
+    print('   * "--src-hpp" is used to generate the header named by "--header" (=%c.hpp), always')
+    print('     with "--qualify-std-namespace". "--include-guard" defaults to _%C_HPP_.')
+    print('   * "--src-cpp" is used to generate %c.cpp.')
+    print('   * "--src-fwd" is used to generate the forward header of every protocol.')
+    print('   * Files whose content is unchanged are not written, so their timestamps are kept.')
+    print('   * A hash of every interface is stored in the file .wlcppgen-manifest of the output')
+    print('     directory. It covers the interface, the interfaces it requires, the options, the')
+    print('     templates and wlcppgen itself. Only interfaces whose hash changed are generated')
+    print('     again. Delete the manifest to generate everything.')
 
 def list_classes(specs, options):
     for spec in specs:
@@ -1346,6 +2200,122 @@ def list_interfaces(specs, options):
         for interface in filtered_interfaces:
             print(interface.name)
 
+def write_if_changed(filename, lines):
+    content = str()
+    for line in lines:
+        content += line + '\n'
+    try:
+        with open(filename) as f:
+            if f.read() == content:
+                return False
+    except IOError:
+        pass
+    with open(filename, 'w') as f:
+        f.write(content)
+    return True
+
+def read_manifest(filename):
+    result = dict()
+    try:
+        with open(filename) as f:
+            for line in f:
+                fields = line.split()
+                if len(fields) == 2:
+                    result[fields[0]] = fields[1]
+    except IOError:
+        pass
+    return result
+
+# Header and source of the interface table of a protocol in --output-dir mode.
+# The table needs a translation unit of its own, which includes all classes,
+# while the header only declares the lookup function. It includes nothing but
+# the files given by --extra-includes, which has to provide the string_ref
+# type.
+interface_table_header_template = '''// wlcpp <hook id="includeguard.ifndef"/>
+// wlcpp <hook id="includeguard.define"/>
+
+#include <cstddef>
+// wlcpp <hook id="include.extra"/>
+
+// wlcpp <hook id="spec.copyright"/>
+
+// wlcpp <hook id="namespace.open"/>
+
+// wlcpp <hook id="spec.hpp.interface_table"/>
+
+// wlcpp <hook id="namespace.close"/>
+
+// wlcpp <hook id="includeguard.endif"/>'''
+
+interface_table_template = '''// wlcpp <hook id="include.interface_table"/>
+// wlcpp <hook id="include.interfaces"/>
+
+// wlcpp <hook id="namespace.using"/>
+
+// wlcpp <hook id="spec.copyright"/>
+
+// wlcpp <hook id="spec.cpp.interface_table"/>'''
+
+def generate_output_dir(specs, src_hpp_template, src_cpp_template, src_fwd_template, output_dir, options):
+    manifest_file = os.path.join(output_dir, manifest_filename)
+    manifest = read_manifest(manifest_file)
+    new_manifest = dict()
+
+    for spec in specs:
+        if src_fwd_template is not None:
+            filename = forward_header(spec, options)
+            fwd_options = copy.copy(options)
+            fwd_options.include_guard = '_' + filename.upper().replace('.', '_') + '_'
+            if write_if_changed(os.path.join(output_dir, filename), src_fwd_template.generate([spec], fwd_options)):
+                print('generated file ' + filename)
+
+        if options.interface_table and src_cpp_template is not None:
+            filename = interface_table_header(spec)
+            header_options = copy.copy(options)
+            header_options.include_guard = '_' + filename.upper().replace('.', '_') + '_'
+            if write_if_changed(os.path.join(output_dir, filename), SourceTemplate(interface_table_header_template).generate([spec], header_options)):
+                print('generated file ' + filename)
+
+            filename = identifier(spec.name) + '_interfaces.cpp'
+            if write_if_changed(os.path.join(output_dir, filename), SourceTemplate(interface_table_template).generate([spec], options)):
+                print('generated file ' + filename)
+
+        hashes = spec.interface_hashes(options, [src_hpp_template, src_cpp_template, src_fwd_template])
+        for interface in filter_interfaces(spec.interfaces, options):
+            interface_options = copy.copy(options)
+            interface_options.only = [interface.name]
+            interface_options.interface_table = False
+            hpp_filename = substitute(options.header, interface_options)
+            cpp_filename = mangle_interface_name(interface.name, options) + '.cpp'
+            new_manifest[interface.name] = hashes[interface.name]
+
+            filenames = list()
+            if src_hpp_template is not None:
+                filenames.append(hpp_filename)
+            if src_cpp_template is not None:
+                filenames.append(cpp_filename)
+            up_to_date = manifest.get(interface.name) == hashes[interface.name]
+            for filename in filenames:
+                up_to_date = up_to_date and os.path.exists(os.path.join(output_dir, filename))
+            if up_to_date:
+                continue
+
+            outputs = list()
+            if src_hpp_template is not None:
+                hpp_options = copy.copy(interface_options)
+                hpp_options.qualify_std_namespace = True
+                outputs.append((hpp_filename, src_hpp_template.generate([spec], hpp_options)))
+            if src_cpp_template is not None:
+                outputs.append((cpp_filename, src_cpp_template.generate([spec], interface_options)))
+            for filename, result in outputs:
+                if write_if_changed(os.path.join(output_dir, filename), result):
+                    print('generated file ' + filename)
+
+    manifest_lines = list()
+    for name in sorted(new_manifest):
+        manifest_lines.append(name + ' ' + new_manifest[name])
+    write_if_changed(manifest_file, manifest_lines)
+
 def print_version():
     print('wlcppgen ', end='')
     print(wlcppgen_version[0], wlcppgen_version[1], wlcppgen_version[2], sep='.')
@@ -1357,7 +2327,13 @@ def main(argv=None):
     commands = set()
     spec_files = list()
     src_file = None
+    src_hpp_file = None
+    src_cpp_file = None
+    src_fwd_file = None
     dst_file = None
+    output_dir = None
+    header_given = False
+    include_guard_given = False
     options = GeneratorOptions()
 
     try:
@@ -1371,21 +2347,35 @@ def main(argv=None):
                 'version',
                 # Options
                 'src=', 'dst=',
+                'src-hpp=', 'src-cpp=', 'src-fwd=', 'output-dir=',
+                'amalgamate',
+                'array-types=',
+                'array-view=',
+                'dispatcher',
                 'exclude=',
                 'extra-includes=',
+                'forward-header=',
+                'handler-model=',
+                'handler-storage=',
+                'handler-type=',
                 'header=',
                 'ignore-events',
                 'include-guard=',
                 'indent=',
                 'indent-tabs',
+                'inline-handlers=',
                 'interface-prefix=',
                 'interface-strip=',
+                'interface-table',
                 'linewidth=',
                 'macro-prefix=',
                 'namespace=',
                 'only=',
                 'proxy=',
-                'qualify-std-namespace'
+                'proxy-base=',
+                'qualify-std-namespace',
+                'request-args',
+                'string-ref='
             ])
 
             for opt, val in opts:
@@ -1403,26 +2393,64 @@ def main(argv=None):
                 # Options
                 elif opt == '--src':
                     src_file = val
+                elif opt == '--src-hpp':
+                    src_hpp_file = val
+                elif opt == '--src-cpp':
+                    src_cpp_file = val
+                elif opt == '--src-fwd':
+                    src_fwd_file = val
                 elif opt == '--dst':
                     dst_file = val
+                elif opt == '--output-dir':
+                    output_dir = val
                 elif opt == '--header':
                     options.header = val
+                    header_given = True
+                elif opt == '--amalgamate':
+                    options.amalgamate = True
+                elif opt == '--array-types':
+                    for array_type in val.split(','):
+                        path, sep, element_type = array_type.partition(':')
+                        if len(sep) == 0 or len(element_type) == 0:
+                            raise UsageError('Invalid array type "' + array_type + '"')
+                        options.array_types[path] = element_type
+                elif opt == '--array-view':
+                    options.array_view = val
+                elif opt == '--dispatcher':
+                    options.dispatcher = True
                 elif opt == '--exclude':
                     options.exclude = val.split(',')
                 elif opt == '--extra-includes':
                     options.extra_includes = val.split(',')
+                elif opt == '--forward-header':
+                    options.forward_header = val
+                elif opt == '--handler-model':
+                    if val not in ['function', 'static']:
+                        raise UsageError('Unknown handler model "' + val + '"')
+                    options.handler_model = val
+                elif opt == '--handler-storage':
+                    if val not in ['inline', 'sparse']:
+                        raise UsageError('Unknown handler storage "' + val + '"')
+                    options.handler_storage = val
+                elif opt == '--handler-type':
+                    options.handler_type = val
                 elif opt == '--ignore-events':
                     options.ignore_events = True
                 elif opt == '--include-guard':
                     options.include_guard = val
+                    include_guard_given = True
                 elif opt == '--indent':
                     options.indent = int(val)
                 elif opt == '--indent-tabs':
                     options.indent_tabs = True
+                elif opt == '--inline-handlers':
+                    options.inline_handlers = val.split(',')
                 elif opt == '--interface-prefix':
                     options.interface_prefix = val
                 elif opt == '--interface-strip':
                     options.interface_strip = val.split(',')
+                elif opt == '--interface-table':
+                    options.interface_table = True
                 elif opt == '--linewidth':
                     options.linewidth = int(val)
                 elif opt == '--macro-prefix':
@@ -1433,8 +2461,14 @@ def main(argv=None):
                     options.only = val.split(',')
                 elif opt == '--proxy':
                     options.proxy = val
+                elif opt == '--proxy-base':
+                    options.proxy_base = val
                 elif opt == '--qualify-std-namespace':
                     options.qualify_std_namespace = True
+                elif opt == '--request-args':
+                    options.request_args = True
+                elif opt == '--string-ref':
+                    options.string_ref = val
 
             # Check that only one command is given and default to generate
             if len(commands) == 0:
@@ -1450,9 +2484,38 @@ def main(argv=None):
                 else:
                     spec_files = args
 
-            # Read source template
+            if 'generate' in commands and output_dir is not None:
+                if src_hpp_file is None and src_cpp_file is None and src_fwd_file is None:
+                    raise UsageError('--output-dir requires --src-hpp, --src-cpp or --src-fwd')
+                if src_file is not None or dst_file is not None:
+                    raise UsageError('--output-dir cannot be combined with --src or --dst')
+                if options.amalgamate:
+                    raise UsageError('--output-dir cannot be combined with --amalgamate')
+                if options.interface_table and (src_hpp_file is None or src_cpp_file is None):
+                    raise UsageError('--interface-table requires --src-hpp and --src-cpp with --output-dir')
+                if not header_given:
+                    options.header = '%c.hpp'
+                if not include_guard_given:
+                    options.include_guard = '_%C_HPP_'
+
+            # Read source templates
             if 'generate' in commands:
-                if src_file is None or src_file == '-':
+                if output_dir is not None:
+                    src_hpp_template = None
+                    src_cpp_template = None
+                    src_fwd_template = None
+                    if src_fwd_file is not None:
+                        if len(options.forward_header) == 0:
+                            raise UsageError('--src-fwd requires --forward-header')
+                        with open(src_fwd_file) as f:
+                            src_fwd_template = SourceTemplate(f.read())
+                    if src_hpp_file is not None:
+                        with open(src_hpp_file) as f:
+                            src_hpp_template = SourceTemplate(f.read())
+                    if src_cpp_file is not None:
+                        with open(src_cpp_file) as f:
+                            src_cpp_template = SourceTemplate(f.read())
+                elif src_file is None or src_file == '-':
                     src_hpp_template = SourceTemplate(sys.stdin.read())
                 else:
                     with open(src_file) as f:
@@ -1466,16 +2529,15 @@ def main(argv=None):
                         specs.append(Specification(f.read()))
 
             # Execute specified command
-            if 'generate' in commands:
+            if 'generate' in commands and output_dir is not None:
+                generate_output_dir(specs, src_hpp_template, src_cpp_template, src_fwd_template, output_dir, options)
+            elif 'generate' in commands:
                 result = src_hpp_template.generate(specs, options)
                 if dst_file is None or dst_file == '-':
                     for line in result:
                         print(line)
                 else:
-                    with open(dst_file, 'w') as f:
-                        for line in result:
-                            f.write(line)
-                            f.write('\n')
+                    write_if_changed(dst_file, result)
 
             if 'help' in commands:
                 print_usage()